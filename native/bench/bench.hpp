@@ -0,0 +1,60 @@
+/**
+ * @file bench.hpp
+ * @brief 主机端基准测试公共工具
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace bench {
+
+/// 全局迭代倍率 (命令行 --quick 时降低)
+extern uint32_t g_scale;
+
+/**
+ * @brief 让编译器认为 v 已被使用，防止被测计算被优化掉 (不产生内存写入)
+ */
+template <typename T>
+inline void do_not_optimize(const T& v) {
+    asm volatile("" : : "r,m"(v) : "memory");
+}
+
+/**
+ * @brief 计时执行 fn() 共 iters 次，打印每单位耗时
+ *
+ * @param group 分组名 (如 "effect")
+ * @param name  项目名
+ * @param iters 迭代次数
+ * @param unitsPerIter 每次迭代处理的单位数 (如字节数)，用于折算 ns/unit
+ * @param unit  单位名 (如 "frame", "byte")
+ * @return 每单位纳秒数
+ */
+template <typename F>
+double run(const char* group, const char* name, uint32_t iters, uint32_t unitsPerIter, const char* unit, F&& fn) {
+    iters = iters * g_scale / 100;
+    if (iters == 0) iters = 1;
+
+    // 预热
+    for (uint32_t i = 0; i < iters / 10 + 1; i++) fn();
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iters; i++) fn();
+    auto t1 = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    double per = ns / ((double)iters * unitsPerIter);
+    printf("%-8s %-24s %10.1f ns/%s\n", group, name, per, unit);
+    return per;
+}
+
+void lamp_effects();
+void lamp_drain(); // 模拟 LampTask 帧开头：执行已投递的控制命令
+void lamp_task();  // 实际运行 LampTask，统计 m_mutex 持有时长 (启动后其他基准不得再直接驱动 lamp)
+void ld2410d();
+void network();
+void stream();     // 本机发送 DDP / E1.31，统计收包到 show() 的延迟 (须在 lamp_task() 之后)
+
+} // namespace bench
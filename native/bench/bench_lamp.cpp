@@ -0,0 +1,305 @@
+/**
+ * @file bench_lamp.cpp
+ * @brief LampController 帧渲染基准：每种 EffectMode 的 runEffect() 单帧耗时 (含从文件存储流式播放动画)、图层合成、定点波形发生器、颜色渐变插值、状态快照读取，
+ *        以及实际运行 LampTask 时的 m_mutex 持有时长
+ */
+
+#include "bench.hpp"
+#include "src/app/lamp.hpp"
+#include "src/app/lamp_wave.hpp"
+#include "src/system/file_store.hpp"
+#include <math.h>
+
+namespace {
+
+constexpr uint16_t kAnimFrames = 64;
+
+/**
+ * @brief 写入一段测试动画 (每帧 frameMs)：彩虹逐帧旋转 1 格，并有一个亮点扫过 (大部分像素每帧都变化)
+ */
+size_t write_animation(uint16_t frameMs) {
+    file_store_begin();
+    File f = LittleFS.open("/anim.bin", "w");
+    uint8_t hdr[ANIM_HEADER_SIZE];
+    anim_make_header(hdr, kAnimFrames);
+    f.write(hdr, sizeof(hdr));
+
+    CRGB prev[FRAME_PIXELS], cur[FRAME_PIXELS];
+    fill_solid(prev, FRAME_PIXELS, CRGB::Black);
+    uint8_t rec[ANIM_FRAME_HEADER_SIZE + ANIM_MAX_FRAME_BYTES];
+    for (uint16_t n = 0; n < kAnimFrames; n++) {
+        for (uint8_t i = 0; i < FRAME_PIXELS; i++) cur[i] = CHSV((uint8_t)((i + n) * 4), 255, 255);
+        cur[n % FRAME_PIXELS] = CRGB::White;
+        const size_t len = anim_encode_delta(prev, cur, rec + ANIM_FRAME_HEADER_SIZE, ANIM_MAX_FRAME_BYTES);
+        rec[0] = (uint8_t)(frameMs & 0xFF);
+        rec[1] = (uint8_t)(frameMs >> 8);
+        rec[2] = (uint8_t)(len & 0xFF);
+        rec[3] = (uint8_t)(len >> 8);
+        f.write(rec, ANIM_FRAME_HEADER_SIZE + len);
+        memcpy(prev, cur, sizeof(cur));
+    }
+    const size_t size = f.size();
+    f.close();
+    return size;
+}
+
+} // namespace
+
+/**
+ * @brief 直接驱动 LampController 内部帧步进 (lamp.hpp 中声明为友元)
+ */
+class LampBench {
+public:
+    static void run() {
+        lamp.init();
+
+        lamp.m_on = true;
+        lamp.setBrightnessQ16(80u << 16);
+        lamp.cancelFade();
+
+        struct Item { EffectMode mode; const char* name; };
+        static const Item items[] = {
+            {EffectMode::Rainbow,   "Rainbow"},
+            {EffectMode::Breathing, "Breathing"},
+            {EffectMode::Police,    "Police"},
+            {EffectMode::Spin,      "Spin"},
+            {EffectMode::Meteor,    "Meteor"},
+            {EffectMode::Fire,      "Fire"},
+            {EffectMode::Candle,    "Candle"},
+            {EffectMode::Aurora,    "Aurora"},
+        };
+
+        // 静态 (无特效) 模式下每帧走 update()
+        lamp.m_effect = EffectMode::None;
+        lamp.m_useCCT = true;
+        bench::run("effect", "None/update (CCT)", 200000, 1, "frame", [] { lamp.update(); });
+        lamp.m_useCCT = false;
+        bench::run("effect", "None/update (RGB)", 200000, 1, "frame", [] { lamp.update(); });
+        lamp.m_useCCT = true;
+
+        // 渐变中的小数亮度：每帧 sigma-delta 抖动，缩放表在两槽间切换
+        lamp.setBrightnessQ16((3u << 16) | 0x5555);
+        bench::run("effect", "None/update (dither)", 200000, 1, "frame", [] { lamp.update(); });
+        lamp.setBrightnessQ16(80u << 16);
+
+        for (const auto& it : items) {
+            lamp.m_effect = it.mode;
+            lamp.m_effectMs = 0;
+            bench::run("effect", it.name, 100000, 1, "frame", [] { lamp.runEffect(LampController::STEP_MS * 1000); });
+        }
+        lamp.m_effect = EffectMode::None;
+
+        // 动画：每帧时长等于步进周期，每次 runEffect 都从文件解码一帧 (最坏情况)
+        const size_t animBytes = write_animation(LampController::STEP_MS);
+        lamp.m_effect = EffectMode::Animation;
+        lamp.m_effectMs = 0;
+        lamp.beginAnimation();
+        fs::File::readCount() = 0;
+        static uint32_t animSteps = 0;
+        bench::run("effect", "Animation (stream)", 100000, 1, "frame", [] {
+            lamp.runEffect(LampController::STEP_MS * 1000);
+            animSteps++;
+        });
+        printf("%-8s %-24s %10.2f reads/frame (file %u bytes, %u frames)\n", "effect", "Animation flash reads",
+               (double)fs::File::readCount() / animSteps, (unsigned)animBytes, kAnimFrames);
+        lamp.m_effect = EffectMode::None;
+
+        // 图层合成：CCT 底色叠加流星 (Add)，以及特效切换交叉淡化中的一帧
+        lamp.m_overlays[0] = {EffectMode::Meteor, BlendMode::Add, 255, 0, 0};
+        bench::run("compose", "CCT + Meteor (add)", 100000, 1, "frame", [] { lamp.runEffect(LampController::STEP_MS * 1000); });
+        lamp.m_overlays[0].mode = EffectMode::None;
+        lamp.m_effect = EffectMode::Spin;
+        lamp.m_xfadeFrom = {EffectMode::Rainbow, BlendMode::Alpha, 255, 0, 0};
+        lamp.m_xfadeAlpha = 128;
+        bench::run("compose", "crossfade Rainbow->Spin", 100000, 1, "frame", [] { lamp.runEffect(LampController::STEP_MS * 1000); });
+        lamp.m_xfadeAlpha = 255;
+        lamp.m_effect = EffectMode::None;
+
+        // 分区不一致时：静态模式逐块填色，特效模式逐分区缩放
+        lamp.applyZone(1, ZoneParams{1, 40, 3000, 0, 0, 0}, ZF_LEVEL | ZF_CCT, 0, 0);
+        lamp.applyZone(2, ZoneParams{1, 70, 0, 255, 0, 0}, ZF_LEVEL | ZF_RGB, 0, 0);
+        bench::run("zone", "None/update (4 zones)", 200000, 1, "frame", [] { lamp.update(); });
+        lamp.m_effect = EffectMode::Rainbow;
+        bench::run("zone", "Rainbow (4 zones)", 100000, 1, "frame", [] { lamp.runEffect(LampController::STEP_MS * 1000); });
+        lamp.m_effect = EffectMode::None;
+        for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+            lamp.applyZone(i, ZoneParams{1, 100, 0, 0, 0, 0}, ZF_ON | ZF_LEVEL | ZF_FOLLOW, 0, 0);
+        }
+
+        // 调色板：缓存未命中时把 16 节点渐变展开为 256 项 (三个调色板轮换，两槽缓存每次都未命中)
+        static PaletteCache palettes;
+        static uint8_t next = 0;
+        bench::run("palette", "expand (miss)", 100000, 1, "call", [] {
+            static const PaletteId ids[] = {PaletteId::Rainbow, PaletteId::Fire, PaletteId::Sunset};
+            palettes.get(ids[next], CRGB::White);
+            next = (next + 1) % 3;
+        });
+        bench::run("palette", "get (hit)", 1000000, 1, "call", [] { palettes.get(PaletteId::Fire, CRGB::White); });
+
+        // 颜色渐变：每帧一次插值 + 转回 sRGB (红 -> 绿)
+        static ColorFade fade;
+        static uint32_t progress = 0;
+        struct SpaceItem { ColorSpace space; const char* name; };
+        static const SpaceItem spaces[] = {
+            {ColorSpace::Gamma,  "fade step gamma (before)"},
+            {ColorSpace::Linear, "fade step linear"},
+            {ColorSpace::OKLab,  "fade step oklab"},
+        };
+        for (const SpaceItem &it : spaces) {
+            fade.begin(it.space, CRGB(255, 0, 0), CRGB(0, 255, 0));
+            bench::run("color", it.name, 1000000, 1, "frame", [] {
+                CRGB c = fade.at(progress);
+                bench::do_not_optimize(c);
+                progress = (progress + 37) & 0xFFFF;
+            });
+        }
+
+        // 色温 -> RGB：普朗克表插值 + 校准矩阵 (缓存未命中时的开销；命中时只是一次比较)
+        static uint16_t cctK = LAMP_CCT_MIN;
+        static const CctCalibration cal = CctCalibration::identity();
+        bench::run("color", "cct_to_rgb (miss)", 1000000, 1, "call", [] {
+            CRGB c = cct_to_rgb(cctK, cal);
+            bench::do_not_optimize(c);
+            cctK = cctK >= LAMP_CCT_MAX ? LAMP_CCT_MIN : cctK + 7;
+        });
+
+        // 色温输出与 ColorFade 使用同一颜色模型 (sRGB)：暖白作为渐变端点原样返回，
+        // 线性光中经过一次往返 (同色端点的中点) 也不变
+        {
+            const CRGB warm = cct_to_rgb(LAMP_CCT_MIN, cal);
+            bool ok = true;
+            for (const SpaceItem &it : spaces) {
+                fade.begin(it.space, warm, warm);
+                ok = ok && fade.at(0) == warm;
+            }
+            fade.begin(ColorSpace::Linear, warm, warm);
+            ok = ok && fade.at(32768) == warm;
+            printf("%-8s %-24s %10s (%uK = %u,%u,%u)\n", "color", "cct -> ColorFade roundtrip", ok ? "ok" : "MISMATCH",
+                   LAMP_CCT_MIN, warm.r, warm.g, warm.b);
+        }
+
+        // 波形发生器：旧实现 exp(sin()) (双精度 libm) 与 Q15 查表对比，每次计算一帧的亮度
+        static volatile uint32_t ms = 0;
+        bench::run("wave", "breath libm (before)", 1000000, 1, "frame", [] {
+            float val = (exp(sin(ms / 2000.0 * PI)) - 0.36787944) * 108.0;
+            if (val < 0) val = 0;
+            if (val > 255) val = 255;
+            bench::do_not_optimize(map((uint8_t)val, 0, 255, 50, 255));
+            ms = ms + LampController::STEP_MS;
+        });
+        bench::run("wave", "breath Q15", 1000000, 1, "frame", [] {
+            bench::do_not_optimize(wave_to_u8(wave_breath(wave_phase(ms, 4000)), 50, 255));
+            ms = ms + LampController::STEP_MS;
+        });
+        bench::run("wave", "sine Q15", 1000000, 1, "frame", [] {
+            bench::do_not_optimize((uint8_t)(wave_sine(wave_phase(ms, 4000)) >> 8));
+            ms = ms + LampController::STEP_MS;
+        });
+        bench::run("wave", "ease(triangle) Q15", 1000000, 1, "frame", [] {
+            bench::do_not_optimize((uint8_t)(wave_ease(wave_triangle(wave_phase(ms, 4000))) >> 7));
+            ms = ms + LampController::STEP_MS;
+        });
+
+        // 渐变引擎：1 条与 5 条轨道同时推进的单帧开销
+        static TweenEngine tween;
+        static TweenEngine::Update updates[TweenEngine::kMaxTracks];
+        for (uint8_t tracks : {1, 5}) {
+            tween.cancelAll();
+            bench::run("tween", tracks == 1 ? "step 1 track" : "step 5 tracks", 1000000, 1, "frame", [tracks] {
+                if (!tween.anyActive()) {
+                    for (uint8_t k = 0; k < tracks; k++) {
+                        tween.start(k, 0, 6500, 60000, FadeCurve::Smoothstep);
+                    }
+                }
+                tween.step(LampController::STEP_MS, updates);
+            });
+        }
+
+        // 慢速渐变调度：30 分钟日出 (亮度 0->100 + 色温 2700->6500K)，静态模式下只在输出变化时唤醒
+        lamp.m_effect = EffectMode::None;
+        lamp.m_useCCT = true;
+        lamp.m_cct = LAMP_CCT_MIN;
+        lamp.setBrightnessQ16(0);
+        lamp.applyBrightness(100, 30u * 60 * 1000, 0);
+        lamp.applyCCT(LAMP_CCT_MAX, 30u * 60 * 1000, 0);
+        bench::run("tween", "nextChangeMs (sunrise)", 100000, 1, "call", [] {
+            bench::do_not_optimize(lamp.m_tween.nextChangeMs(LampController::TWEEN_SLEEP_MIN_MS,
+                                                             LampController::tweenOutputChanged, &lamp));
+        });
+        uint32_t wakeups = 0;
+        while (lamp.m_tween.anyActive()) {
+            lamp.scheduleTweens();
+            lamp.advanceTweens((lamp.m_tweenSleep ? lamp.m_tweenWaitMs : LampController::STEP_MS) * 1000);
+            wakeups++;
+        }
+        lamp.scheduleTweens();
+        printf("%-8s %-24s %10u wakeups (frame clock: %u)\n", "tween", "sunrise 30min schedule", wakeups,
+               30u * 60 * 1000 / LampController::STEP_MS);
+
+        // 指定时长不随亮度差缩放：从 50% 出发的 30 分钟睡眠渐变同样历时 30 分钟
+        {
+            const uint32_t fadeMs = 30u * 60 * 1000;
+            lamp.setBrightnessQ16((uint32_t)50 << 16);
+            lamp.applyBrightness(1, fadeMs, 0);
+            uint32_t elapsedMs = 0;
+            while (lamp.m_tween.anyActive()) {
+                lamp.scheduleTweens();
+                const uint32_t stepMs = lamp.m_tweenSleep ? lamp.m_tweenWaitMs : LampController::STEP_MS;
+                lamp.advanceTweens(stepMs * 1000);
+                elapsedMs += stepMs;
+            }
+            lamp.scheduleTweens();
+            const bool ok = elapsedMs >= fadeMs && elapsedMs <= fadeMs + LampController::TWEEN_MAX_SLEEP_MS;
+            printf("%-8s %-24s %10s (%u s for 50%% -> 1%%)\n", "tween", "sleep 30min from 50%", ok ? "ok" : "MISMATCH",
+                   (unsigned)(elapsedMs / 1000));
+        }
+
+        // 读者侧：一次一致的状态快照读取
+        lamp.publishState();
+        bench::run("state", "getState", 1000000, 1, "call", [] {
+            LampStateSnapshot st;
+            lamp.getState(st);
+        });
+    }
+
+    static void drain() {
+        lamp.drainCommands();
+    }
+
+    /**
+     * @brief 运行真实 LampTask 播放特效，报告每帧 m_mutex 持有时长
+     *
+     * show() 在锁外执行，持锁时间应为微秒级，而非 WS2812 传输的约 2ms。
+     */
+    static void task() {
+        lamp.startTask();
+        lamp.setPower(true, 0);
+        lamp.setEffect(EffectMode::Rainbow);
+        delay(50);
+        lamp.resetLockStats();
+        delay(bench::g_scale >= 100 ? 2000 : 300);
+
+        LampLockStats st;
+        lamp.getLockStats(st);
+        uint32_t shown, skipped;
+        lamp.getFrameStats(shown, skipped);
+        printf("%-8s %-24s %10.1f us/frame (max %u us, %u frames, shown %u)\n", "task", "mutex hold",
+               st.count ? (double)st.totalUs / st.count : 0.0, st.maxUs, st.count, shown);
+    }
+};
+
+namespace bench {
+
+void lamp_effects() {
+    LampBench::run();
+}
+
+void lamp_drain() {
+    LampBench::drain();
+}
+
+void lamp_task() {
+    LampBench::task();
+}
+
+} // namespace bench
@@ -0,0 +1,75 @@
+/**
+ * @file bench_ld2410d.cpp
+ * @brief LD2410D 串口帧解析基准：processByte() 每字节耗时
+ */
+
+#include "bench.hpp"
+#include "src/sensors/ld2410d.hpp"
+
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 循环回放一段字节序列的 Stream
+ */
+class ReplayStream : public Stream {
+public:
+    explicit ReplayStream(const std::vector<uint8_t>& data) : m_data(data) {}
+
+    void arm(size_t bytes) { m_remaining = bytes; }
+
+    int available() override { return (int)m_remaining; }
+    int read() override {
+        if (m_remaining == 0) return -1;
+        m_remaining--;
+        uint8_t b = m_data[m_pos];
+        if (++m_pos >= m_data.size()) m_pos = 0;
+        return b;
+    }
+    size_t write(uint8_t) override { return 1; }
+
+private:
+    const std::vector<uint8_t>& m_data;
+    size_t m_pos = 0;
+    size_t m_remaining = 0;
+};
+
+// 工程模式上报帧: Head(4) + Len(2) + State(1) + Dist(2) + Energy(128) + Tail(4)
+std::vector<uint8_t> make_engineering_frame(uint16_t distance_cm) {
+    std::vector<uint8_t> f = {0xF4, 0xF3, 0xF2, 0xF1};
+    const uint16_t len = 1 + 2 + 128;
+    f.push_back(len & 0xFF);
+    f.push_back(len >> 8);
+    f.push_back(0x01);
+    f.push_back(distance_cm & 0xFF);
+    f.push_back(distance_cm >> 8);
+    for (uint32_t i = 0; i < 32; i++) {
+        uint32_t e = i * 1000u;
+        for (int k = 0; k < 4; k++) f.push_back((e >> (8 * k)) & 0xFF);
+    }
+    f.insert(f.end(), {0xF8, 0xF7, 0xF6, 0xF5});
+    return f;
+}
+
+} // namespace
+
+namespace bench {
+
+void ld2410d() {
+    const std::vector<uint8_t> frame = make_engineering_frame(123);
+    ReplayStream stream(frame);
+    Sensor::LD2410D radar(stream);
+
+    const size_t bytesPerIter = frame.size() * 4;
+    bench::run("ld2410d", "processByte", 20000, (uint32_t)bytesPerIter, "byte", [&] {
+        stream.arm(bytesPerIter);
+        radar.update();
+    });
+
+    if (radar.getData().distance_cm != 123) {
+        printf("ld2410d  WARNING: frame not decoded (distance=%u)\n", radar.getData().distance_cm);
+    }
+}
+
+} // namespace bench
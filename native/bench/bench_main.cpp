@@ -0,0 +1,28 @@
+/**
+ * @file bench_main.cpp
+ * @brief 主机端基准测试入口
+ *
+ * 用法: lamp_bench [--quick]
+ *   --quick  迭代次数降至 5%，用于 CI 冒烟
+ */
+
+#include "bench.hpp"
+
+#include <cstring>
+
+namespace bench {
+uint32_t g_scale = 100;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) bench::g_scale = 5;
+    }
+
+    bench::lamp_effects();
+    bench::ld2410d();
+    bench::network();
+    bench::lamp_task();
+    bench::stream();
+    return 0;
+}
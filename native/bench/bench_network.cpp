@@ -0,0 +1,34 @@
+/**
+ * @file bench_network.cpp
+ * @brief MQTT/BLE 指令处理与状态上报基准
+ *
+ * mqtt_task.cpp 的状态上报函数为文件内 static，这里将其直接并入本编译单元。
+ * 指令只投递到 LampController 命令队列，每次调用后由 lamp_drain() 代替 LampTask 执行。
+ */
+
+#include "bench.hpp"
+#include "src/network/mqtt_task.cpp"
+#include "src/network/ble_cmd.hpp"
+
+namespace bench {
+
+void network() {
+    init_topics();
+    client.connect("bench");
+
+    bench::run("mqtt", "publish_state", 100000, 1, "call", [] { publish_state(); });
+
+    char payload[] = "42";
+    bench::run("mqtt", "callback brightness", 100000, 1, "call", [&] {
+        mqtt_callback((char*)g_topics.brightness_set.c_str(), (byte*)payload, 2);
+        lamp_drain();
+    });
+
+    const std::string cmd = "cct:3500";
+    bench::run("ble", "handle_command cct", 100000, 1, "call", [&] {
+        ble_handle_command(cmd);
+        lamp_drain();
+    });
+}
+
+} // namespace bench
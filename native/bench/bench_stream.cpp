@@ -0,0 +1,99 @@
+/**
+ * @file bench_stream.cpp
+ * @brief 实时像素流：本机发送 DDP / E1.31，测量收包到 show() 完成的延迟
+ *
+ * 须在 lamp_task() 之后运行 (依赖真实 LampTask)。主机端 show() 按 WS2812 时序休眠，
+ * 因此延迟包含约 2ms 的线上传输时间。
+ */
+
+#include "bench.hpp"
+#include "src/app/lamp.hpp"
+#include "src/network/udp_stream.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <thread>
+
+namespace {
+
+constexpr size_t kLedBytes = LAMP_NUM_LEDS * 3;
+
+size_t make_ddp(uint8_t* buf, uint8_t seq, uint8_t shade) {
+    buf[0] = 0x40 | 0x01; // V1 + PUSH
+    buf[1] = seq;
+    buf[2] = 0x0B;        // RGB 8 位
+    buf[3] = 1;           // 默认输出
+    memset(buf + 4, 0, 4); // 偏移 0
+    buf[8] = kLedBytes >> 8;
+    buf[9] = kLedBytes & 0xFF;
+    memset(buf + 10, shade, kLedBytes);
+    return 10 + kLedBytes;
+}
+
+size_t make_e131(uint8_t* buf, uint8_t seq, uint8_t shade) {
+    memset(buf, 0, 126);
+    buf[1] = 0x10;
+    memcpy(buf + 4, "ASC-E1.17", 9);
+    buf[21] = 0x04;       // 根层：数据包
+    buf[43] = 0x02;       // 帧层：DMX 数据
+    buf[108] = 100;       // 优先级
+    buf[111] = seq;
+    buf[114] = UDP_STREAM_E131_UNIVERSE;
+    buf[117] = 0x02;
+    buf[118] = 0xA1;
+    buf[122] = 1;         // 地址增量
+    buf[123] = (kLedBytes + 1) >> 8;
+    buf[124] = (kLedBytes + 1) & 0xFF;
+    memset(buf + 126, shade, kLedBytes);
+    return 126 + kLedBytes;
+}
+
+template <typename Make>
+void run_sender(const char* name, uint16_t port, Make make) {
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(port);
+    dst.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    const int frames = bench::g_scale >= 100 ? 500 : 50;
+    uint8_t buf[1024];
+    lamp.resetStreamStats();
+    for (int i = 0; i < frames; i++) {
+        const size_t n = make(buf, (uint8_t)(i + 1), (uint8_t)(i * 7));
+        sendto(sock, buf, n, 0, (sockaddr*)&dst, sizeof(dst));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // 200fps，大于一次 show()
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    close(sock);
+
+    LampStreamStats st;
+    lamp.getStreamStats(st);
+    printf("%-8s %-24s %10.1f us/frame (max %u us, %d sent, %u shown)\n", "stream", name,
+           st.frames ? (double)st.totalUs / st.frames : 0.0, st.maxUs, frames, st.frames);
+}
+
+} // namespace
+
+namespace bench {
+
+void stream() {
+    udp_stream_set_enable(true); // 接收端默认关闭
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // 等待绑定端口
+
+    run_sender("DDP packet->show", UDP_STREAM_DDP_PORT, make_ddp);
+    run_sender("E1.31 packet->show", UDP_STREAM_E131_PORT, [](uint8_t* buf, uint8_t seq, uint8_t shade) {
+        return make_e131(buf, seq, shade);
+    });
+
+    UdpStreamStats rx;
+    udp_stream_get_stats(rx);
+    printf("%-8s %-24s %u packets, %u frames, %u out of order, %u invalid\n", "stream", "receiver",
+           rx.packets, rx.frames, rx.outOfOrder, rx.invalid);
+}
+
+} // namespace bench
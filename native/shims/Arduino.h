@@ -0,0 +1,205 @@
+/**
+ * @file Arduino.h
+ * @brief 主机端 (Linux) Arduino 核心最小替身
+ *
+ * 仅实现固件中实际用到的接口：millis/micros/delay/map、String、Print/Stream、
+ * Serial 与 ESP 对象。语义尽量贴近 ESP32 Arduino Core，便于在主机上编译并
+ * 基准测试 app/sensors/network 中的热点路径。
+ */
+
+#pragma once
+
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define IRAM_ATTR
+#define DEC 10
+#define HEX 16
+
+// ---- 时间 ----
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+// ---- 数学 ----
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    const long run = in_max - in_min;
+    if (run == 0) return out_min;
+    return (x - in_min) * (out_max - out_min) / run + out_min;
+}
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+// ---- String ----
+class String {
+public:
+    String() = default;
+    String(const char *s) : s_(s ? s : "") {}
+    String(const std::string &s) : s_(s) {}
+    String(char c) : s_(1, c) {}
+    String(int v, unsigned char base = DEC) { fromInteger((long long)v, base); }
+    String(unsigned int v, unsigned char base = DEC) { fromUnsigned(v, base); }
+    String(long v, unsigned char base = DEC) { fromInteger(v, base); }
+    String(unsigned long v, unsigned char base = DEC) { fromUnsigned(v, base); }
+    String(float v, unsigned int decimals = 2) { fromDouble(v, decimals); }
+    String(double v, unsigned int decimals = 2) { fromDouble(v, decimals); }
+
+    const char *c_str() const { return s_.c_str(); }
+    unsigned int length() const { return (unsigned int)s_.size(); }
+    void reserve(unsigned int n) { s_.reserve(n); }
+
+    String &operator+=(const String &o) { s_ += o.s_; return *this; }
+    String &operator+=(const char *o) { s_ += (o ? o : ""); return *this; }
+    String &operator+=(char c) { s_ += c; return *this; }
+
+    bool operator==(const String &o) const { return s_ == o.s_; }
+    bool operator==(const char *o) const { return s_ == (o ? o : ""); }
+    bool operator!=(const String &o) const { return s_ != o.s_; }
+    bool operator!=(const char *o) const { return !(*this == o); }
+    char operator[](unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+
+    void toLowerCase() { for (auto &c : s_) c = (char)tolower((unsigned char)c); }
+    void toUpperCase() { for (auto &c : s_) c = (char)toupper((unsigned char)c); }
+    bool equalsIgnoreCase(const String &o) const { return strcasecmp(s_.c_str(), o.s_.c_str()) == 0; }
+    bool startsWith(const String &p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+    int indexOf(char c, unsigned int from = 0) const {
+        auto pos = s_.find(c, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    String substring(unsigned int from) const { return from >= s_.size() ? String() : String(s_.substr(from)); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= s_.size()) return String();
+        return String(s_.substr(from, to - from));
+    }
+    void trim() {
+        size_t b = 0, e = s_.size();
+        while (b < e && isspace((unsigned char)s_[b])) b++;
+        while (e > b && isspace((unsigned char)s_[e - 1])) e--;
+        s_ = s_.substr(b, e - b);
+    }
+    long toInt() const { return atol(s_.c_str()); }
+    float toFloat() const { return (float)atof(s_.c_str()); }
+
+    friend String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+    friend String operator+(const String &a, const char *b) { String r(a); r += b; return r; }
+    friend String operator+(const char *a, const String &b) { String r(a); r += b; return r; }
+
+private:
+    std::string s_;
+
+    void fromUnsigned(unsigned long long v, unsigned char base) {
+        char buf[72];
+        char *p = buf + sizeof(buf) - 1;
+        *p = '\0';
+        do {
+            unsigned d = (unsigned)(v % base);
+            *--p = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+            v /= base;
+        } while (v);
+        s_ = p;
+    }
+    void fromInteger(long long v, unsigned char base) {
+        if (v < 0 && base == DEC) {
+            fromUnsigned((unsigned long long)(-v), base);
+            s_.insert(s_.begin(), '-');
+        } else {
+            fromUnsigned((unsigned long long)v, base);
+        }
+    }
+    void fromDouble(double v, unsigned int decimals) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        s_ = buf;
+    }
+};
+
+// ---- Print / Stream ----
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t len) {
+        size_t n = 0;
+        while (len--) n += write(*buf++);
+        return n;
+    }
+    size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t print(const String &s) { return print(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return print(String(v)); }
+    size_t print(unsigned int v) { return print(String(v)); }
+    size_t print(long v) { return print(String(v)); }
+    size_t print(unsigned long v) { return print(String(v)); }
+    size_t print(double v, int decimals = 2) { return print(String(v, (unsigned)decimals)); }
+    size_t println() { return print("\r\n"); }
+    template <typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[256];
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        if (n <= 0) return 0;
+        return write((const uint8_t *)buf, strnlen(buf, sizeof(buf)));
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() { return -1; }
+    virtual void flush() {}
+};
+
+/**
+ * @brief 主机端串口：写入 stdout，无输入
+ */
+class HardwareSerial : public Stream {
+public:
+    explicit HardwareSerial(int uart = 0) : uart_(uart) {}
+    void begin(unsigned long, uint32_t = 0, int8_t = -1, int8_t = -1) {}
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+    size_t write(const uint8_t *buf, size_t len) override { return fwrite(buf, 1, len, stdout); }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    explicit operator bool() const { return true; }
+
+private:
+    int uart_;
+};
+
+#define SERIAL_8N1 0x800001c
+extern HardwareSerial Serial;
+
+// ---- ESP 对象 ----
+class EspClass {
+public:
+    [[noreturn]] void restart();
+    uint64_t getEfuseMac() const { return 0x0000A1B2C3D4E5F6ULL; }
+    uint32_t getFreeHeap() const { return 29 * 1024; }
+};
+
+extern EspClass ESP;
+
+inline bool setCpuFrequencyMhz(uint32_t) { return true; }
@@ -0,0 +1,6 @@
+/**
+ * @file ArduinoJson.h
+ * @brief 主机端占位头文件 (被编译的模块不使用 JSON 解析)
+ */
+
+#pragma once
@@ -0,0 +1,117 @@
+/**
+ * @file FS.h
+ * @brief 主机端 Arduino 文件系统替身 (进程内存储)
+ *
+ * 以路径为索引保存文件内容；只实现固件用到的 File/FS 接口。
+ * readCount() 统计 read() 调用次数，便于在主机上观察播放时的闪存访问次数。
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs {
+
+class File {
+public:
+    File() = default;
+    File(std::shared_ptr<std::vector<uint8_t>> data, bool writable) : data_(std::move(data)), writable_(writable) {
+        if (writable_) pos_ = data_->size(); // "w" 已截断，"a" 追加
+    }
+
+    explicit operator bool() const { return data_ != nullptr; }
+
+    size_t write(const uint8_t *buf, size_t len) {
+        if (!data_ || !writable_) return 0;
+        if (pos_ + len > data_->size()) data_->resize(pos_ + len);
+        memcpy(data_->data() + pos_, buf, len);
+        pos_ += len;
+        return len;
+    }
+    size_t write(uint8_t b) { return write(&b, 1); }
+    size_t read(uint8_t *buf, size_t len) {
+        if (!data_) return 0;
+        readCount()++;
+        size_t n = pos_ < data_->size() ? data_->size() - pos_ : 0;
+        if (n > len) n = len;
+        memcpy(buf, data_->data() + pos_, n);
+        pos_ += n;
+        return n;
+    }
+    int read() {
+        uint8_t b;
+        return read(&b, 1) == 1 ? b : -1;
+    }
+    bool seek(uint32_t pos) {
+        if (!data_ || pos > data_->size()) return false;
+        pos_ = pos;
+        return true;
+    }
+    size_t position() const { return pos_; }
+    size_t size() const { return data_ ? data_->size() : 0; }
+    int available() const { return data_ && pos_ < data_->size() ? (int)(data_->size() - pos_) : 0; }
+    void flush() {}
+    void close() { data_.reset(); }
+
+    /// 累计 read() 次数 (所有文件)
+    static uint32_t &readCount() {
+        static uint32_t count = 0;
+        return count;
+    }
+
+private:
+    std::shared_ptr<std::vector<uint8_t>> data_;
+    bool writable_ = false;
+    size_t pos_ = 0;
+};
+
+class FS {
+public:
+    File open(const char *path, const char *mode = "r", bool create = false) {
+        (void)create;
+        const std::string p = path ? path : "";
+        auto it = files().find(p);
+        if (mode[0] == 'r') {
+            if (it == files().end()) return File();
+            return File(it->second, false);
+        }
+        if (it == files().end() || mode[0] == 'w') {
+            files()[p] = std::make_shared<std::vector<uint8_t>>();
+        }
+        return File(files()[p], true);
+    }
+    File open(const String &path, const char *mode = "r", bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char *path) { return files().count(path ? path : "") != 0; }
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path) { return files().erase(path ? path : "") != 0; }
+    bool remove(const String &path) { return remove(path.c_str()); }
+    bool rename(const char *from, const char *to) {
+        auto it = files().find(from);
+        if (it == files().end()) return false;
+        files()[to] = it->second;
+        files().erase(from);
+        return true;
+    }
+    bool rename(const String &from, const String &to) { return rename(from.c_str(), to.c_str()); }
+
+    size_t usedBytes() const {
+        size_t n = 0;
+        for (const auto &f : files()) n += f.second->size();
+        return n;
+    }
+
+protected:
+    static std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> &files() {
+        static std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> s;
+        return s;
+    }
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,228 @@
+/**
+ * @file FastLED.h
+ * @brief 主机端 FastLED 最小替身
+ *
+ * 提供 CRGB/CHSV、8 位缩放运算、fill_* 辅助函数以及不驱动硬件的
+ * CFastLED::show()。算术与 FastLED 保持一致 (FASTLED_SCALE8_FIXED=1)，
+ * 以便主机端基准测试反映真实的每像素运算量。show() 按 WS2812 时序
+ * 休眠等量时间，使调用方的阻塞时长与真机一致。
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+// ---- 8 位定点运算 ----
+inline uint8_t scale8(uint8_t i, uint8_t scale) {
+    return (uint8_t)(((uint16_t)i * (1 + (uint16_t)scale)) >> 8);
+}
+
+inline uint8_t scale8_video(uint8_t i, uint8_t scale) {
+    return (uint8_t)((((uint16_t)i * (uint16_t)scale) >> 8) + ((i && scale) ? 1 : 0));
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+    unsigned t = (unsigned)i + j;
+    return (uint8_t)(t > 255 ? 255 : t);
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j) {
+    return (uint8_t)(i > j ? i - j : 0);
+}
+
+struct CHSV {
+    union {
+        struct {
+            uint8_t hue;
+            uint8_t sat;
+            uint8_t val;
+        };
+        uint8_t raw[3];
+    };
+    CHSV() : hue(0), sat(0), val(0) {}
+    CHSV(uint8_t h, uint8_t s, uint8_t v) : hue(h), sat(s), val(v) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb);
+
+struct CRGB {
+    union {
+        struct {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Green = 0x008000,
+        Orange = 0xFFA500,
+        Red = 0xFF0000,
+        White = 0xFFFFFF,
+        Yellow = 0xFFFF00,
+    };
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+    CRGB(uint32_t colorcode)
+        : r((uint8_t)(colorcode >> 16)), g((uint8_t)(colorcode >> 8)), b((uint8_t)colorcode) {}
+    CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+    CRGB(const CHSV &hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+    CRGB &operator=(const CHSV &hsv) {
+        hsv2rgb_rainbow(hsv, *this);
+        return *this;
+    }
+
+    uint8_t &operator[](uint8_t i) { return raw[i]; }
+    const uint8_t &operator[](uint8_t i) const { return raw[i]; }
+
+    CRGB &setRGB(uint8_t nr, uint8_t ng, uint8_t nb) {
+        r = nr; g = ng; b = nb;
+        return *this;
+    }
+
+    CRGB &setHSV(uint8_t hue, uint8_t sat, uint8_t val) {
+        hsv2rgb_rainbow(CHSV(hue, sat, val), *this);
+        return *this;
+    }
+
+    CRGB &nscale8(uint8_t scaledown) {
+        r = scale8(r, scaledown);
+        g = scale8(g, scaledown);
+        b = scale8(b, scaledown);
+        return *this;
+    }
+
+    CRGB &fadeToBlackBy(uint8_t fadefactor) { return nscale8(255 - fadefactor); }
+
+    CRGB &operator+=(const CRGB &rhs) {
+        r = qadd8(r, rhs.r);
+        g = qadd8(g, rhs.g);
+        b = qadd8(b, rhs.b);
+        return *this;
+    }
+};
+
+inline bool operator==(const CRGB &a, const CRGB &b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+inline bool operator!=(const CRGB &a, const CRGB &b) { return !(a == b); }
+
+inline void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb) {
+    const uint8_t hue = hsv.hue;
+    uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+
+    const uint8_t offset8 = (uint8_t)((hue & 0x1F) << 3);
+    const uint8_t third = scale8(offset8, 85);
+    uint8_t r, g, b;
+
+    if (!(hue & 0x80)) {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) { r = 255 - third; g = third; b = 0; }
+            else { r = 171; g = 85 + third; b = 0; }
+        } else {
+            if (!(hue & 0x20)) { uint8_t twothirds = scale8(offset8, 170); r = 171 - twothirds; g = 170 + third; b = 0; }
+            else { r = 0; g = 255 - third; b = third; }
+        }
+    } else {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) { uint8_t twothirds = scale8(offset8, 170); r = 0; g = 171 - twothirds; b = 85 + twothirds; }
+            else { r = third; g = 0; b = 255 - third; }
+        } else {
+            if (!(hue & 0x20)) { r = 85 + third; g = 0; b = 171 - third; }
+            else { r = 170 + third; g = 0; b = 85 - third; }
+        }
+    }
+
+    if (sat != 255) {
+        if (sat == 0) {
+            r = g = b = 255;
+        } else {
+            uint8_t desat = 255 - sat;
+            desat = scale8_video(desat, desat);
+            uint8_t satscale = 255 - desat;
+            r = scale8(r, satscale) + desat;
+            g = scale8(g, satscale) + desat;
+            b = scale8(b, satscale) + desat;
+        }
+    }
+
+    if (val != 255) {
+        val = scale8_video(val, val);
+        r = scale8(r, val);
+        g = scale8(g, val);
+        b = scale8(b, val);
+    }
+
+    rgb.r = r; rgb.g = g; rgb.b = b;
+}
+
+// ---- 批量填充 ----
+inline void fill_solid(CRGB *leds, int numToFill, const CRGB &color) {
+    for (int i = 0; i < numToFill; i++) leds[i] = color;
+}
+
+inline void fill_rainbow(CRGB *leds, int numToFill, uint8_t initialhue, uint8_t deltahue = 5) {
+    CHSV hsv(initialhue, 240, 255);
+    for (int i = 0; i < numToFill; i++) {
+        leds[i] = hsv;
+        hsv.hue += deltahue;
+    }
+}
+
+inline void nscale8(CRGB *leds, uint16_t numLeds, uint8_t scale) {
+    for (uint16_t i = 0; i < numLeds; i++) leds[i].nscale8(scale);
+}
+
+inline void fadeToBlackBy(CRGB *leds, uint16_t numLeds, uint8_t fadeBy) {
+    nscale8(leds, numLeds, 255 - fadeBy);
+}
+
+// ---- 控制器 ----
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class WS2812 {};
+template <uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class WS2812B {};
+
+/**
+ * @brief 主机端 FastLED 控制器：show() 不输出，仅计数并模拟线上传输时间
+ */
+class CFastLED {
+public:
+    template <template <uint8_t, EOrder> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+    CFastLED &addLeds(CRGB *data, int nLeds) {
+        m_leds = data;
+        m_numLeds = nLeds;
+        return *this;
+    }
+
+    /// 每像素 24bit x 1.25us = 30us，另加 50us 复位；64 像素约 2ms
+    void show() {
+        m_showCount++;
+        std::this_thread::sleep_for(std::chrono::microseconds(m_numLeds * 30 + 50));
+    }
+    void clear(bool writeData = false) {
+        if (m_leds) memset((void *)m_leds, 0, sizeof(CRGB) * m_numLeds);
+        if (writeData) show();
+    }
+    void setBrightness(uint8_t scale) { m_brightness = scale; }
+    uint8_t getBrightness() const { return m_brightness; }
+
+    /// 主机端专用：累计 show() 次数
+    uint32_t showCount() const { return m_showCount; }
+
+private:
+    CRGB *m_leds = nullptr;
+    int m_numLeds = 0;
+    uint8_t m_brightness = 255;
+    uint32_t m_showCount = 0;
+};
+
+extern CFastLED FastLED;
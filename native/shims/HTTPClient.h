@@ -0,0 +1,8 @@
+/**
+ * @file HTTPClient.h
+ * @brief 主机端占位头文件 (被编译的模块不发起 HTTP 请求)
+ */
+
+#pragma once
+
+#include <Arduino.h>
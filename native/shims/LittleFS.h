@@ -0,0 +1,32 @@
+/**
+ * @file LittleFS.h
+ * @brief 主机端 LittleFS 替身：挂载总是成功，容量按 partitions.csv 中的 spiffs 分区计
+ */
+
+#pragma once
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+    bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char *partitionLabel = "spiffs") {
+        (void)formatOnFail;
+        (void)basePath;
+        (void)maxOpenFiles;
+        (void)partitionLabel;
+        return true;
+    }
+    void end() {}
+    bool format() {
+        files().clear();
+        return true;
+    }
+    size_t totalBytes() const { return 0xF0000; }
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,87 @@
+/**
+ * @file LovyanGFX.hpp
+ * @brief 主机端 LovyanGFX 替身：仅满足 LGFX_ESP32.hpp 的类型需求
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#define SPI2_HOST 1
+#define SPI_DMA_CH_AUTO 3
+
+namespace lgfx {
+
+class Light_PWM {
+public:
+    struct config_t {
+        int pin_bl = -1;
+        bool invert = false;
+        uint32_t freq = 0;
+        int pwm_channel = 0;
+    };
+    config_t config() const { return cfg_; }
+    void config(const config_t &cfg) { cfg_ = cfg; }
+
+private:
+    config_t cfg_;
+};
+
+class Bus_SPI {
+public:
+    struct config_t {
+        int spi_host = 0;
+        uint8_t spi_mode = 0;
+        uint32_t freq_write = 0;
+        uint32_t freq_read = 0;
+        bool spi_3wire = false;
+        bool use_lock = false;
+        int dma_channel = 0;
+        int pin_sclk = -1;
+        int pin_mosi = -1;
+        int pin_miso = -1;
+        int pin_dc = -1;
+    };
+    config_t config() const { return cfg_; }
+    void config(const config_t &cfg) { cfg_ = cfg; }
+
+private:
+    config_t cfg_;
+};
+
+class Panel_ST7789 {
+public:
+    struct config_t {
+        int pin_cs = -1;
+        int pin_rst = -1;
+        int pin_busy = -1;
+        uint16_t panel_width = 0;
+        uint16_t panel_height = 0;
+        uint16_t memory_width = 0;
+        uint16_t memory_height = 0;
+        int16_t offset_x = 0;
+        int16_t offset_y = 0;
+        uint8_t offset_rotation = 0;
+        bool invert = false;
+        bool rgb_order = false;
+        bool dlen_16bit = false;
+        bool bus_shared = false;
+    };
+    config_t config() const { return cfg_; }
+    void config(const config_t &cfg) { cfg_ = cfg; }
+    void setBus(Bus_SPI *) {}
+    void setLight(Light_PWM *) {}
+
+private:
+    config_t cfg_;
+};
+
+class LGFX_Device {
+public:
+    void setPanel(Panel_ST7789 *) {}
+    bool init() { return true; }
+    void setRotation(uint8_t) {}
+    void setBrightness(uint8_t) {}
+};
+
+} // namespace lgfx
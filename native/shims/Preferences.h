@@ -0,0 +1,96 @@
+/**
+ * @file Preferences.h
+ * @brief 主机端 NVS Preferences 替身 (进程内存储)
+ *
+ * 以 "命名空间/键" 为索引保存原始字节；putCount() 统计写入次数，
+ * 便于在主机上观察延迟提交等逻辑产生的 NVS 写放大。
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false) {
+        (void)readOnly;
+        ns_ = name ? name : "";
+        return true;
+    }
+    void end() {}
+
+    bool isKey(const char *key) { return store().count(k(key)) != 0; }
+    bool remove(const char *key) { return store().erase(k(key)) != 0; }
+    bool clear() {
+        for (auto it = store().begin(); it != store().end();) {
+            if (it->first.compare(0, ns_.size() + 1, ns_ + "/") == 0) it = store().erase(it);
+            else ++it;
+        }
+        return true;
+    }
+
+    size_t putUChar(const char *key, uint8_t v) { return put(key, v); }
+    size_t putUShort(const char *key, uint16_t v) { return put(key, v); }
+    size_t putUInt(const char *key, uint32_t v) { return put(key, v); }
+    size_t putInt(const char *key, int32_t v) { return put(key, v); }
+    size_t putBool(const char *key, bool v) { return put(key, (uint8_t)(v ? 1 : 0)); }
+    size_t putFloat(const char *key, float v) { return put(key, v); }
+    size_t putBytes(const char *key, const void *buf, size_t len) {
+        const auto *p = static_cast<const uint8_t *>(buf);
+        store()[k(key)] = std::vector<uint8_t>(p, p + len);
+        putCount()++;
+        return len;
+    }
+    size_t putString(const char *key, const String &v) { return putBytes(key, v.c_str(), v.length() + 1); }
+    size_t putString(const char *key, const char *v) { return putString(key, String(v)); }
+
+    uint8_t getUChar(const char *key, uint8_t def = 0) { return get(key, def); }
+    uint16_t getUShort(const char *key, uint16_t def = 0) { return get(key, def); }
+    uint32_t getUInt(const char *key, uint32_t def = 0) { return get(key, def); }
+    int32_t getInt(const char *key, int32_t def = 0) { return get(key, def); }
+    bool getBool(const char *key, bool def = false) { return get(key, (uint8_t)(def ? 1 : 0)) != 0; }
+    float getFloat(const char *key, float def = 0.0f) { return get(key, def); }
+    size_t getBytesLength(const char *key) {
+        auto it = store().find(k(key));
+        return it == store().end() ? 0 : it->second.size();
+    }
+    size_t getBytes(const char *key, void *buf, size_t maxLen) {
+        auto it = store().find(k(key));
+        if (it == store().end()) return 0;
+        size_t n = it->second.size() < maxLen ? it->second.size() : maxLen;
+        memcpy(buf, it->second.data(), n);
+        return n;
+    }
+    String getString(const char *key, const String &def = String()) {
+        auto it = store().find(k(key));
+        if (it == store().end() || it->second.empty()) return def;
+        return String((const char *)it->second.data());
+    }
+
+    /// 累计写入次数 (所有命名空间)
+    static uint32_t &putCount() {
+        static uint32_t count = 0;
+        return count;
+    }
+
+private:
+    std::string ns_;
+
+    static std::map<std::string, std::vector<uint8_t>> &store() {
+        static std::map<std::string, std::vector<uint8_t>> s;
+        return s;
+    }
+    std::string k(const char *key) const { return ns_ + "/" + (key ? key : ""); }
+
+    template <typename T> size_t put(const char *key, T v) { return putBytes(key, &v, sizeof(v)); }
+    template <typename T> T get(const char *key, T def) {
+        auto it = store().find(k(key));
+        if (it == store().end() || it->second.size() != sizeof(T)) return def;
+        T v;
+        memcpy(&v, it->second.data(), sizeof(T));
+        return v;
+    }
+};
@@ -0,0 +1,55 @@
+/**
+ * @file PubSubClient.h
+ * @brief 主机端 PubSubClient 替身：不联网，仅统计发布的消息与字节数
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+#define MQTT_CALLBACK_SIGNATURE void (*callback)(char *, uint8_t *, unsigned int)
+
+class PubSubClient {
+public:
+    explicit PubSubClient(Client &client) : client_(client) {}
+
+    PubSubClient &setServer(const char *domain, uint16_t port) { (void)domain; (void)port; return *this; }
+    PubSubClient &setCallback(MQTT_CALLBACK_SIGNATURE) { callback_ = callback; return *this; }
+    bool setBufferSize(uint16_t size) { bufferSize_ = size; return true; }
+
+    bool connect(const char *id, const char *user = nullptr, const char *pass = nullptr,
+                 const char *willTopic = nullptr, uint8_t willQos = 0, bool willRetain = false,
+                 const char *willMessage = nullptr) {
+        (void)id; (void)user; (void)pass; (void)willTopic; (void)willQos; (void)willRetain; (void)willMessage;
+        connected_ = true;
+        return true;
+    }
+    void disconnect() { connected_ = false; }
+    bool connected() { return connected_; }
+    int state() { return connected_ ? 0 : -1; }
+    bool loop() { return connected_; }
+    bool subscribe(const char *topic, uint8_t qos = 0) { (void)topic; (void)qos; return connected_; }
+
+    bool publish(const char *topic, const char *payload, bool retained = false) {
+        (void)retained;
+        if (!connected_) return false;
+        size_t len = strlen(topic) + strlen(payload);
+        if (len + 7 > bufferSize_) return false;
+        messages_++;
+        bytes_ += len;
+        return true;
+    }
+
+    /// 主机端专用：发布统计
+    uint32_t publishedMessages() const { return messages_; }
+    uint64_t publishedBytes() const { return bytes_; }
+
+private:
+    Client &client_;
+    void (*callback_)(char *, uint8_t *, unsigned int) = nullptr;
+    uint16_t bufferSize_ = 256;
+    bool connected_ = false;
+    uint32_t messages_ = 0;
+    uint64_t bytes_ = 0;
+};
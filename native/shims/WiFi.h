@@ -0,0 +1,46 @@
+/**
+ * @file WiFi.h
+ * @brief 主机端 WiFi 替身：始终处于已连接状态
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_DISCONNECTED = 6,
+    WL_CONNECTED = 3,
+} wl_status_t;
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : a_(a), b_(b), c_(c), d_(d) {}
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", a_, b_, c_, d_);
+        return String(buf);
+    }
+
+private:
+    uint8_t a_, b_, c_, d_;
+};
+
+class Client : public Stream {
+public:
+    size_t write(uint8_t) override { return 1; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    virtual bool connected() { return true; }
+};
+
+class WiFiClient : public Client {};
+
+class WiFiClass {
+public:
+    wl_status_t status() const { return WL_CONNECTED; }
+    IPAddress localIP() const { return IPAddress(192, 168, 1, 42); }
+    int8_t RSSI() const { return -55; }
+};
+
+extern WiFiClass WiFi;
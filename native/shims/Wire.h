@@ -0,0 +1,15 @@
+/**
+ * @file Wire.h
+ * @brief 主机端 I2C 替身 (仅类型，不通信)
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1) { (void)sda; (void)scl; return true; }
+};
+
+extern TwoWire Wire;
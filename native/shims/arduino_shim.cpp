@@ -0,0 +1,46 @@
+/**
+ * @file arduino_shim.cpp
+ * @brief 主机端 Arduino 核心替身实现
+ */
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial(0);
+EspClass ESP;
+
+static const auto s_boot = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - s_boot).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - s_boot).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static std::minstd_rand s_rng(1);
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return (long)(s_rng() % (unsigned long)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+void EspClass::restart() {
+    fflush(stdout);
+    std::exit(0);
+}
@@ -0,0 +1,29 @@
+/**
+ * @file FreeRTOS.h
+ * @brief 主机端 FreeRTOS 最小替身 (基础类型与宏)
+ *
+ * 1 tick = 1 ms，与 ESP32 Arduino 默认 configTICK_RATE_HZ 一致。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ 1000
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000u))
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define errQUEUE_FULL pdFAIL
+
+#define portYIELD_FROM_ISR(...) ((void)0)
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
@@ -0,0 +1,19 @@
+/**
+ * @file queue.h
+ * @brief 主机端 FreeRTOS 队列替身 (定长元素，按值拷贝)
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct QueueShim;
+typedef QueueShim *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticksToWait);
+BaseType_t xQueueSendToBack(QueueHandle_t q, const void *item, TickType_t ticksToWait);
+BaseType_t xQueueReceive(QueueHandle_t q, void *out, TickType_t ticksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+BaseType_t xQueueReset(QueueHandle_t q);
+void vQueueDelete(QueueHandle_t q);
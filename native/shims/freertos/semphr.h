@@ -0,0 +1,19 @@
+/**
+ * @file semphr.h
+ * @brief 主机端 FreeRTOS 信号量/互斥量替身
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct SemaphoreShim;
+typedef SemaphoreShim *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higherPriorityTaskWoken);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
@@ -0,0 +1,240 @@
+/**
+ * @file freertos_shim.cpp
+ * @brief 主机端 FreeRTOS 替身实现 (std::thread + 条件变量)
+ */
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+unsigned long millis();
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 等待直到 pred 成立或超时；ticks == portMAX_DELAY 表示无限等待
+template <typename Pred>
+bool waitFor(std::condition_variable &cv, std::unique_lock<std::mutex> &lk, TickType_t ticks, Pred pred) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lk, pred);
+        return true;
+    }
+    if (ticks == 0) return pred(); // 不阻塞：避免 wait_for(0) 进入内核计时等待
+    return cv.wait_for(lk, std::chrono::milliseconds(ticks), pred);
+}
+
+} // namespace
+
+// =================================================================================
+// 任务
+// =================================================================================
+
+struct TaskShim {
+    std::mutex mtx;
+    std::condition_variable cv;
+    uint32_t notifyValue = 0;
+    bool suspended = false;
+};
+
+static thread_local TaskShim *t_currentTask = nullptr;
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stackDepth,
+                       void *param, UBaseType_t priority, TaskHandle_t *outHandle) {
+    (void)name; (void)stackDepth; (void)priority;
+    auto *task = new TaskShim();
+    if (outHandle) *outHandle = task;
+    std::thread([fn, param, task]() {
+        t_currentTask = task;
+        fn(param);
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stackDepth,
+                                   void *param, UBaseType_t priority, TaskHandle_t *outHandle,
+                                   BaseType_t coreId) {
+    (void)coreId;
+    return xTaskCreate(fn, name, stackDepth, param, priority, outHandle);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // 仅支持任务自删除；主机端任务句柄不回收
+    if (task == nullptr || task == t_currentTask) pthread_exit(nullptr);
+}
+
+void vTaskSuspend(TaskHandle_t task) {
+    TaskShim *t = task ? task : t_currentTask;
+    if (!t) return;
+    std::unique_lock<std::mutex> lk(t->mtx);
+    t->suspended = true;
+    if (t == t_currentTask) t->cv.wait(lk, [t] { return !t->suspended; });
+}
+
+void vTaskResume(TaskHandle_t task) {
+    if (!task) return;
+    std::lock_guard<std::mutex> lk(task->mtx);
+    task->suspended = false;
+    task->cv.notify_all();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+void taskYIELD() {
+    std::this_thread::yield();
+}
+
+void vTaskDelayUntil(TickType_t *previousWake, TickType_t increment) {
+    TickType_t wake = *previousWake + increment;
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(wake - now) > 0) vTaskDelay(wake - now);
+    *previousWake = wake;
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return t_currentTask;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (!task) return pdFAIL;
+    std::lock_guard<std::mutex> lk(task->mtx);
+    task->notifyValue++;
+    task->cv.notify_all();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait) {
+    TaskShim *t = t_currentTask;
+    if (!t) {
+        vTaskDelay(ticksToWait == portMAX_DELAY ? 0 : ticksToWait);
+        return 0;
+    }
+    std::unique_lock<std::mutex> lk(t->mtx);
+    waitFor(t->cv, lk, ticksToWait, [t] { return t->notifyValue > 0; });
+    uint32_t v = t->notifyValue;
+    if (v > 0) t->notifyValue = clearOnExit ? 0 : v - 1;
+    return v;
+}
+
+// =================================================================================
+// 信号量 / 互斥量
+// =================================================================================
+
+struct SemaphoreShim {
+    std::mutex mtx;
+    std::condition_variable cv;
+    UBaseType_t count;
+    UBaseType_t maxCount;
+};
+
+static SemaphoreHandle_t createSemaphore(UBaseType_t maxCount, UBaseType_t initialCount) {
+    auto *s = new SemaphoreShim();
+    s->count = initialCount;
+    s->maxCount = maxCount;
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return createSemaphore(1, 1); }
+SemaphoreHandle_t xSemaphoreCreateBinary() { return createSemaphore(1, 0); }
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return createSemaphore(maxCount, initialCount);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticksToWait) {
+    if (!sem) return pdFAIL;
+    std::unique_lock<std::mutex> lk(sem->mtx);
+    if (!waitFor(sem->cv, lk, ticksToWait, [sem] { return sem->count > 0; })) return pdFAIL;
+    sem->count--;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    if (!sem) return pdFAIL;
+    std::lock_guard<std::mutex> lk(sem->mtx);
+    if (sem->count >= sem->maxCount) return pdFAIL;
+    sem->count++;
+    sem->cv.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+    return xSemaphoreGive(sem);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) { delete sem; }
+
+// =================================================================================
+// 队列
+// =================================================================================
+
+struct QueueShim {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::vector<uint8_t>> items;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    auto *q = new QueueShim();
+    q->length = length;
+    q->itemSize = itemSize;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticksToWait) {
+    if (!q) return pdFAIL;
+    std::unique_lock<std::mutex> lk(q->mtx);
+    if (!waitFor(q->cv, lk, ticksToWait, [q] { return q->items.size() < q->length; })) return errQUEUE_FULL;
+    const auto *p = static_cast<const uint8_t *>(item);
+    q->items.emplace_back(p, p + q->itemSize);
+    q->cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t q, const void *item, TickType_t ticksToWait) {
+    return xQueueSend(q, item, ticksToWait);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *out, TickType_t ticksToWait) {
+    if (!q) return pdFAIL;
+    std::unique_lock<std::mutex> lk(q->mtx);
+    if (!waitFor(q->cv, lk, ticksToWait, [q] { return !q->items.empty(); })) return pdFAIL;
+    memcpy(out, q->items.front().data(), q->itemSize);
+    q->items.pop_front();
+    q->cv.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    if (!q) return 0;
+    std::lock_guard<std::mutex> lk(q->mtx);
+    return (UBaseType_t)q->items.size();
+}
+
+BaseType_t xQueueReset(QueueHandle_t q) {
+    if (!q) return pdFAIL;
+    std::lock_guard<std::mutex> lk(q->mtx);
+    q->items.clear();
+    q->cv.notify_all();
+    return pdPASS;
+}
+
+void vQueueDelete(QueueHandle_t q) { delete q; }
@@ -0,0 +1,14 @@
+/**
+ * @file libs_shim.cpp
+ * @brief 主机端第三方库替身的全局对象
+ */
+
+#include <FastLED.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <Wire.h>
+
+CFastLED FastLED;
+fs::LittleFSFS LittleFS;
+WiFiClass WiFi;
+TwoWire Wire;
@@ -0,0 +1,41 @@
+/**
+ * @file firmware_stubs.cpp
+ * @brief 主机端未参与编译的固件模块的空实现
+ *
+ * GUI、传感器驱动、WiFi/天气任务与 BLE 协议栈依赖硬件或 LVGL/NimBLE，
+ * 主机构建只链接被测模块，这里为其外部符号提供最小实现。
+ */
+
+#include "src/ui/gui_task.hpp"
+#include "src/network/ble_task.hpp"
+#include "src/network/weather_task.hpp"
+#include "src/network/wifi_task.hpp"
+#include "src/sensors/bh1750.hpp"
+#include "src/sensors/sht4x.hpp"
+
+// ---- GUI ----
+QueueHandle_t uiEventQueue = nullptr;
+char s_ipBuffer[16] = {0};
+
+void send_ui_event(const UIEvent& evt, uint8_t excludeMask) {
+    (void)evt;
+    (void)excludeMask;
+}
+
+// ---- BLE ----
+QueueHandle_t bleEventQueue = nullptr;
+
+bool is_ble_config_active() { return false; }
+void ble_update_radar_energy(const uint32_t* energy) { (void)energy; }
+void ble_send_notify(const char* msg) { (void)msg; }
+
+// ---- WiFi / 天气 ----
+void wifi_reload_config() {}
+void weather_force_update() {}
+
+// ---- 传感器 ----
+bool bh1750_has_reading() { return true; }
+float bh1750_get_lux() { return 123.4f; }
+bool sht4x_has_reading() { return true; }
+float sht4x_get_temperature() { return 24.5f; }
+float sht4x_get_humidity() { return 45.0f; }
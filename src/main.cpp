@@ -12,6 +12,7 @@
 // ---- System Modules ----
 #include "src/system/i2c_manager.hpp"
 #include "src/system/storage.hpp"
+#include "src/system/file_store.hpp"
 #include "src/system/rtc_task.hpp"
 
 // ---- App Modules ----
@@ -69,6 +70,9 @@ void setup() {
     Serial.println("[Boot] Display Initialized");
     Serial.println("[Boot] GUI Task Started");
 
+    // 文件存储 (动画)：首次启动需格式化，须在灯光初始化前挂载
+    file_store_begin();
+
     // 灯光控制 (FastLED)
     lamp.init();
     lamp.startTask();
@@ -3,7 +3,18 @@
 #include <FastLED.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/queue.h>
+#include <atomic>
 #include "../system/storage.hpp"
+#include "lamp_tween.hpp"
+#include "lamp_geometry.hpp"
+#include "lamp_palette.hpp"
+#include "lamp_color.hpp"
+#include "lamp_cct.hpp"
+#include "lamp_names.hpp"
+#include "lamp_scene.hpp"
+#include "lamp_frame.hpp"
+#include "lamp_anim.hpp"
 
 // LED 配置
 #define LAMP_NUM_LEDS 64
@@ -11,24 +22,26 @@
 #define LAMP_LED_TYPE WS2812
 #define LAMP_COLOR_ORDER GRB
 
+static_assert(LampLayout::kNumLeds == LAMP_NUM_LEDS, "LampLayout 与 LAMP_NUM_LEDS 不一致");
+static_assert(FRAME_PIXELS == LAMP_NUM_LEDS, "二进制帧像素数与 LAMP_NUM_LEDS 不一致");
+
+// 分区：每块面板一个分区 (LED 按面板连续走线，分区 z 为 [z * kPanelLeds, (z + 1) * kPanelLeds))
+#define LAMP_NUM_ZONES LampLayout::kPanels
+#define LAMP_ZONE_LEDS LampLayout::kPanelLeds
+
+static_assert(LAMP_NUM_ZONES <= TWEEN_MAX_ZONES, "分区数超过渐变轨道预留");
+
 // 色温范围（K）
 #define LAMP_CCT_MIN 2700
 #define LAMP_CCT_MAX 6500
 
+static_assert(kCctMinK == LAMP_CCT_MIN && kCctMaxK == LAMP_CCT_MAX, "色温表范围与 LAMP_CCT_MIN/MAX 不一致");
+
 
 // 统一的物理亮度限制（全局映射用）
 static constexpr uint8_t LAMP_PWM_HARD_MIN = 10; // 物理最小占空比
 static constexpr uint8_t LAMP_PWM_HARD_MAX = 80; // 物理最大占空比
 
-// 渐变曲线类型
-enum class FadeCurve : uint8_t {
-	Linear,        // 线性
-	EaseIn,        // 缓入（平方）
-	EaseOut,       // 缓出（平方）
-	EaseInOut,     // 缓入缓出（余弦）
-	Smoothstep     // 更平滑的 S 曲线（smootherstep 近似）
-};
-
 // 灯光特效模式
 enum class EffectMode : uint8_t {
     None = 0,       // 无特效 (静态)
@@ -38,7 +51,139 @@ enum class EffectMode : uint8_t {
     Night,          // 夜灯模式 (微光)
     Reading,        // 阅读模式 (冷白高亮)
     Spin,           // 旋转彩虹 (针对环形布局)
-    Meteor          // 流星拖尾 (针对环形布局)
+    Meteor,         // 流星拖尾 (针对环形布局)
+    Fire,           // 火焰 (噪声场向上翻滚)
+    Candle,         // 烛光摇曳
+    Aurora,         // 极光缓慢漂移
+    Image,          // 上传的静止画面 (lamp_image.cpp)
+    Animation       // 文件存储中的动画，逐帧流式循环播放 (lamp_image.cpp)
+};
+static constexpr uint8_t EFFECT_MODE_COUNT = (uint8_t)EffectMode::Animation + 1;
+
+// 特效显示名 (顺序与 EffectMode 一致)
+inline constexpr const char* kEffectNameList[EFFECT_MODE_COUNT] = {
+    "None", "Rainbow", "Breathing", "Police", "Night", "Reading",
+    "Spin", "Meteor", "Fire", "Candle", "Aurora", "Image",
+    "Animation"
+};
+inline constexpr NameTable<EFFECT_MODE_COUNT, 16> kEffectNames{kEffectNameList};
+static_assert(kEffectNames.valid(), "特效名表未找到无冲突的哈希种子");
+
+inline const char* effect_name(EffectMode mode) {
+    return kEffectNames.name((uint8_t)mode);
+}
+
+// 图层混合方式 (叠加层与其下方的合成结果混合)
+enum class BlendMode : uint8_t {
+    Alpha = 0,      // 按 alpha 覆盖
+    Add,            // 饱和相加 (黑色像素不影响下层)
+    Max             // 逐通道取最大
+};
+
+// 特效运行参数 (每种特效一份；LampTask 热循环直接读取字段，整块持久化到 NVS)
+struct EffectParams {
+    uint8_t speed;       // 时间轴倍率，128 = 1x，0 = 暂停
+    uint8_t intensity;   // 0-255，128 = 默认效果；含义由特效决定 (拖尾长度、火焰高度、闪烁幅度…)
+    PaletteId palette;   // Solid = 使用 CCT/RGB 基色
+    uint8_t reverse;     // 1 = 左右镜像 (运动方向反转)
+};
+
+// setEffectParams() 的字段掩码：只更新被选中的字段
+enum EffectParamField : uint8_t {
+    EFP_SPEED     = 1 << 0,
+    EFP_INTENSITY = 1 << 1,
+    EFP_PALETTE   = 1 << 2,
+    EFP_REVERSE   = 1 << 3,
+    EFP_ALL       = 0x0F
+};
+
+// 分区参数 (setZone 的 fields 掩码选择要修改的字段)
+struct ZoneParams {
+    uint8_t on;          // 0/1
+    uint8_t level;       // 分区亮度 1-100，相对整灯亮度
+    uint16_t cct;        // 色温 K (ZF_CCT)
+    uint8_t r, g, b;     // RGB (ZF_RGB)
+};
+
+enum ZoneField : uint8_t {
+    ZF_ON     = 1 << 0,
+    ZF_LEVEL  = 1 << 1,
+    ZF_CCT    = 1 << 2,  // 覆盖整灯颜色：色温
+    ZF_RGB    = 1 << 3,  // 覆盖整灯颜色：RGB
+    ZF_FOLLOW = 1 << 4   // 取消覆盖，渐变回整灯颜色
+};
+
+// 跨任务控制命令：GUI/MQTT/BLE/按键任务投递，LampTask 在帧开头取出执行
+struct LampCommand {
+    enum class Type : uint8_t {
+        Power,            // value: 0=关 1=开
+        TogglePower,      // 由 LampTask 根据当前状态决定开/关
+        Brightness,       // value: 0-100
+        SavedBrightness,  // value: 0-100
+        CCT,              // value: 色温 K
+        Color,            // r/g/b
+        Effect,           // value: EffectMode
+        Scene,            // scene: 场景名
+        AutoBrightness,   // value: 0/1
+        ReducedFrameRate, // value: 0/1
+        Overlay,          // value: EffectMode, r: 图层序号, g: BlendMode, b: alpha
+        EffectParams,     // r: EffectMode (0xFF = 当前特效), g: EffectParamField 掩码, params
+        CctCalibration,   // calibration
+        SceneStore,       // sceneDef: 新建或覆盖用户场景
+        SceneDelete,      // scene: 场景名
+        Zone              // r: 分区序号, g: ZoneField 掩码, zone
+    };
+
+    Type type;
+    uint8_t excludeMask;
+    uint16_t value;
+    uint32_t fadeMs;              // 渐变时长 (ms，上限 LampController::MAX_FADE_MS)
+    uint8_t r, g, b;
+    union {                       // 按 type 只使用其中一项
+        char scene[12];
+        EffectParams params;
+        CctCalibration calibration;
+        SceneDef sceneDef;
+        ZoneParams zone;
+    };
+};
+
+// 灯光状态快照：LampTask 每次状态变化时发布一份，供 MQTT/BLE/GUI 一致读取
+struct LampStateSnapshot {
+    uint32_t version;          // 发布序号，未变化时读者可跳过处理
+    bool on;
+    uint8_t brightness;        // 当前实际输出亮度 (内部 0-100)
+    uint8_t savedBrightness;   // 用户亮度 1-100
+    bool cctMode;
+    uint16_t cct;              // 渐变中为目标值，与 getCCT() 一致
+    CRGB rgb;                  // 渐变中为目标值，与 getRGB() 一致
+    EffectMode effect;
+    EffectParams params;       // 当前特效的参数
+    bool autoBrightness;
+    char scene[12];
+    bool live;                 // 正在显示实时像素流 (DDP / E1.31)
+    struct Zone {
+        bool on;
+        uint8_t level;         // 1-100，相对整灯亮度
+        bool follow;           // true = 使用整灯颜色 (下列颜色字段为整灯颜色)
+        bool cctMode;
+        uint16_t cct;          // 渐变中为目标值
+        CRGB rgb;
+    } zones[LAMP_NUM_ZONES];
+};
+
+// LampTask 持有 m_mutex 的时长统计 (微秒)
+struct LampLockStats {
+    uint32_t count;
+    uint32_t totalUs;
+    uint32_t maxUs;
+};
+
+// 实时像素流统计：frames 为实际 show() 的流帧数，延迟为收到数据包到 show() 返回 (微秒)
+struct LampStreamStats {
+    uint32_t frames;
+    uint32_t totalUs;
+    uint32_t maxUs;
 };
 
 class LampController {
@@ -47,39 +192,87 @@ public:
 	void init();
 	void startTask();
 
-    // 2. 核心控制接口
-    void setPower(bool on, uint16_t fade_ms, uint8_t excludeMask = 0);   // 逻辑开关（带渐变）
-	void togglePower(uint16_t fade_ms);         // 切换开关
+    // 2. 核心控制接口 (可从任意任务调用：仅投递命令，不阻塞)
+    void setPower(bool on, uint32_t fade_ms, uint8_t excludeMask = 0);   // 逻辑开关（带渐变）
+	void togglePower(uint32_t fade_ms);         // 切换开关
 	bool isOn() const;                          // 获取开关状态
 
-	void setBrightness(uint8_t percent, uint16_t fade_ms = 0, uint8_t excludeMask = 0);  // 0-100, 支持渐变
+	void setBrightness(uint8_t percent, uint32_t fade_ms = 0, uint8_t excludeMask = 0);  // 0-100, 支持渐变
 	uint8_t getBrightness() const;              // 获取当前亮度
 
-	void setCCT(uint16_t cct, uint16_t fade_ms = 0, uint8_t excludeMask = 0);                  // 设置色温 (切换到 CCT 模式)
+	void setCCT(uint16_t cct, uint32_t fade_ms = 0, uint8_t excludeMask = 0);                  // 设置色温 (切换到 CCT 模式)
 	uint16_t getCCT() const;                    // 获取色温
+    void setCctCalibration(const CctCalibration &cal);  // 白点校准矩阵 (持久化到 NVS)
+    bool setCctCalibration(const char* spec);           // 文本形式：9 个浮点数 (行优先) 或 "reset"
 
-    void setColor(uint8_t r, uint8_t g, uint8_t b, uint16_t fade_ms = 0, uint8_t excludeMask = 0); // 设置 RGB 颜色 (切换到 RGB 模式)
+    void setColor(uint8_t r, uint8_t g, uint8_t b, uint32_t fade_ms = 0, uint8_t excludeMask = 0); // 设置 RGB 颜色 (切换到 RGB 模式)
     CRGB getRGB() const;                            // 获取 RGB 颜色
-    void setHSV(uint8_t h, uint8_t s, uint8_t v, uint16_t fade_ms = 0, uint8_t excludeMask = 0);   // 设置 HSV 颜色 (切换到 RGB 模式)
+    void setHSV(uint8_t h, uint8_t s, uint8_t v, uint32_t fade_ms = 0, uint8_t excludeMask = 0);   // 设置 HSV 颜色 (切换到 RGB 模式)
     bool isCCTMode() const;                         // 当前是否为色温模式
 
-    // 特效控制
-    void setEffect(EffectMode mode);
-    void setEffect(const char* effectName); // 根据名称设置特效
+    // 特效控制 (底层特效切换时与旧特效交叉淡化 fade_ms)
+    void setEffect(EffectMode mode, uint32_t fade_ms = EFFECT_CROSSFADE_MS);
+    void setEffect(const char* effectName, uint32_t fade_ms = EFFECT_CROSSFADE_MS); // 根据名称设置特效
     EffectMode getEffect() const;
-    void setScene(const char* scene, uint8_t excludeMask = 0); // 设置场景模式
-    String getScene() const; // 获取当前场景名称
+    // 叠加层 1 .. MAX_LAYERS-1，绘制在底层之上；mode=None 移除该层
+    void setOverlay(uint8_t layer, EffectMode mode, BlendMode blend = BlendMode::Add, uint8_t alpha = 255);
+    static bool effectFromName(const char* name, EffectMode &out); // 特效名 (不区分大小写) -> EffectMode
+    void setEffectPalette(EffectMode mode, PaletteId palette);     // 指定特效使用的调色板
+    void setEffectPalette(PaletteId palette);                      // 当前特效使用的调色板
+    // 特效参数：fields 为 EffectParamField 掩码，未选中的字段保持不变
+    void setEffectParams(EffectMode mode, const EffectParams &params, uint8_t fields = EFP_ALL);
+    void setEffectParams(const EffectParams &params, uint8_t fields); // 作用于当前特效
+    bool setEffectParams(const char* spec); // 文本形式 "[effect,]speed=..,intensity=..,pal=..,dir=rev|fwd"
+
+    static constexpr uint8_t MAX_LAYERS = 3;             // 底层 + 2 个叠加层
+    static constexpr uint16_t EFFECT_CROSSFADE_MS = 500; // 默认特效切换淡化时长
+    static constexpr uint32_t MAX_FADE_MS = 12UL * 3600 * 1000; // 渐变时长上限 (日出/睡眠定时等长渐变)
+    static bool parseUint(const char* text, uint32_t minValue, uint32_t maxValue, uint32_t &out); // 严格十进制整数，须在范围内
+    static bool parseRgb(const char* text, uint8_t &r, uint8_t &g, uint8_t &b); // "r:g:b"，各分量 0-255
+    static bool parseFadeMs(const char* text, uint32_t &out); // 十进制毫秒 0..MAX_FADE_MS，不接受符号与多余字符
+    bool setScene(const char* scene, uint8_t excludeMask = 0); // 设置场景模式 (名称超过 11 字符时拒绝)
+    // 用户场景 (持久化到 NVS)：文本 "name[,bri=80][,cct=4500|rgb=255:120:0][,fade=800]"，
+    // 未给出的字段取当前灯光状态
+    bool saveScene(const char* spec);
+    bool deleteScene(const char* name);
 
 	void setSavedBrightness(uint8_t percent);   // 设置记忆亮度
 	uint8_t getSavedBrightness() const;         // 获取记忆亮度
 
+    // 分区控制 (zone 从 0 开始)：亮度相对整灯亮度，颜色可覆盖整灯颜色
+    static constexpr uint8_t NUM_ZONES = LAMP_NUM_ZONES;
+    void setZone(uint8_t zone, const ZoneParams &params, uint8_t fields, uint32_t fade_ms = 500, uint8_t excludeMask = 0);
+    // 文本形式 "2,on=1,bri=40,cct=3000|rgb=255:0:0,fade=800" / "2,follow" / "2,off" (分区号从 1 开始)
+    bool setZone(const char* spec, uint8_t excludeMask = 0);
+
+    // 任意画面 (lamp_image.cpp)：二进制帧指令 (格式见 lamp_frame.hpp)，
+    // 静止画面直接解码进 Image 特效的画面缓冲，动画转码写入文件存储后由 Animation 特效播放。
+    // source 为指令来源 (DEST_BLE / DEST_MQTT)：动画上传期间只接受发起方的后续指令
+    bool handleFramePacket(const uint8_t* data, size_t len, uint8_t source);
+
+    // 实时像素流 (lamp_stream.cpp)：接收任务持锁把像素直接收进后缓冲，
+    // 停止推送 STREAM_TIMEOUT_MS 后自动恢复当前特效/静态画面
+    static constexpr uint32_t STREAM_TIMEOUT_MS = 2500;
+    CRGB* lockStreamBuffer(TickType_t wait);   // 获取 m_mutex，返回 LAMP_NUM_LEDS 个像素的后缓冲；超时返回 nullptr
+    // 释放 m_mutex；[offset, offset + len) 为实际写入的字节 (len = 0 表示未写入)，push = 帧完整，rxUs 为收包时刻 (micros)
+    void unlockStreamBuffer(uint32_t offset, uint32_t len, bool push, uint32_t rxUs);
+    void endStream();                          // 发送端声明停止 (如 E1.31 Stream_Terminated)，立即恢复
+    void getStreamStats(LampStreamStats &out) const;
+    void resetStreamStats();
+
+    // 状态快照 (可从任意任务调用：无锁、无堆分配)
+    uint32_t getState(LampStateSnapshot &out) const; // 返回快照版本
+    uint32_t stateVersion() const;                   // 仅读取版本，用于判断是否需要重新读取
+
     // 3. 渐变与动画
-	void fadeToBrightness(uint8_t targetPercent, uint16_t duration_ms);
+	void fadeToBrightness(uint8_t targetPercent, uint32_t duration_ms, bool scaleByDistance);
 	void cancelFade();
 	bool isFading() const;
 
 	void setFadeCurve(FadeCurve curve);
 	FadeCurve getFadeCurve() const;
+    void setColorSpace(ColorSpace space);   // RGB 渐变的插值空间 (默认线性光)
+    ColorSpace getColorSpace() const;
 
     // 4. 持久化
 	void flushNow(); // 立即提交脏数据
@@ -88,81 +281,238 @@ public:
     void setAutoBrightness(bool enable);
     bool isAutoBrightness() const;
 
+    // 帧率：省电或 CPU 紧张时降至 25fps，特效与渐变按实际时间推进，观感不变
+    void setReducedFrameRate(bool enable);
+
+    // 6. 诊断
+    void getFrameStats(uint32_t &shown, uint32_t &skipped) const; // show() 实际输出/跳过的帧数
+    void getLockStats(LampLockStats &out) const;                  // LampTask 每帧持有 m_mutex 的时长
+    void resetLockStats();
+
 private:
+    friend class LampBench; // 主机端基准测试 (native/bench) 直接驱动 runEffect()/update()
+
     // 亮度与物理限制常量（供各实现文件复用）
     static constexpr uint8_t kMaxPwmOutput = LAMP_PWM_HARD_MAX;
     static constexpr uint8_t kMinPwmOutput = LAMP_PWM_HARD_MIN;
     static constexpr uint8_t kMinVisibleBrightness = (uint16_t)kMinPwmOutput * 100 / kMaxPwmOutput;
 
-    // Gamma 查表（声明，定义在 lamp_render.cpp）
-    static const uint8_t GAMMA_TABLE[101];
-
-    String m_scene = "None"; // 当前场景名称
+    SceneSlot m_scene = kSceneNone; // 当前场景
+    SceneRegistry m_scenes;  // 内置 + 用户场景
 
     // 5. 内部实现与硬件驱动
 	void update();
     void cctToRawRGB(uint16_t cct, uint8_t &r, uint8_t &g, uint8_t &b);
-	void cctToRGB(uint16_t cct, uint8_t brightness, uint8_t &r, uint8_t &g, uint8_t &b);
-    uint8_t scaleChannel(uint16_t value, uint8_t brightness) const;
+    const uint8_t* channelScaleLut(uint8_t pwm);        // 物理 PWM -> 256 项通道缩放表 (两槽缓存)
+    uint8_t ditheredPwm(uint32_t q16, uint8_t &acc);    // Q16 亮度的本帧 PWM (sigma-delta 抖动，acc 为误差累加)
+    static uint8_t roundedPwm(uint32_t q16);            // Q16 亮度的 PWM (四舍五入，不抖动)
+    void setBrightnessQ16(uint32_t q16);                // 同步更新 m_brightnessQ16 / m_brightness
+    void applyScaleLut(const uint8_t* lut, const CRGB* src, CRGB* dst); // 逐通道查表缩放 (src 可与 dst 相同)
+    void scaleOutput(const CRGB* src, CRGB* dst);       // 把满亮度像素缩放到整灯/分区亮度
+    void scaleOutput() { scaleOutput(m_leds, m_leds); }
+    void presentFrame();                                // 后缓冲 -> 前缓冲 (持锁)，与上帧相同则跳过
+    void flushFrame();                                  // 推送前缓冲 (锁外调用 FastLED.show())
 	
+    // 命令队列 (lamp_command.cpp)
+    bool post(const LampCommand &cmd);    // 非阻塞投递，队列满时丢弃并返回 false
+    void drainCommands();                 // LampTask: 取出并执行全部待处理命令
+    void applyCommand(const LampCommand &cmd);
+
+    // 命令执行 (仅在 LampTask 持有 m_mutex 时调用)
+    void applyPower(bool on, uint32_t fade_ms, uint8_t excludeMask);
+    void applyBrightness(uint8_t percent, uint32_t fade_ms, uint8_t excludeMask);
+    void applyCCT(uint16_t cct, uint32_t fade_ms, uint8_t excludeMask);
+    void applyColor(uint8_t r, uint8_t g, uint8_t b, uint32_t fade_ms, uint8_t excludeMask);
+    void applySavedBrightness(uint8_t percent);
+    void applyEffect(EffectMode mode, uint32_t fade_ms);
+    void applyOverlay(uint8_t layer, EffectMode mode, BlendMode blend, uint8_t alpha);
+    void applyEffectParams(EffectMode mode, const EffectParams &params, uint8_t fields);
+    void applyCctCalibration(const CctCalibration &cal);
+    void applyScene(const char* scene, uint8_t excludeMask);
+    void applySceneDef(SceneSlot slot, const SceneDef &def, uint8_t excludeMask); // 亮度与颜色渐变同帧启动、同时结束
+    void applySceneStore(const SceneDef &def);
+    void applySceneDelete(const char* name);
+    void applyZone(uint8_t zone, const ZoneParams &params, uint8_t fields, uint32_t fade_ms, uint8_t excludeMask);
+    void applyAutoBrightness(bool enable);
+
+    // 状态快照发布 (lamp_state.cpp，仅 LampTask 写入)
+    void publishState();
+
     static void taskEntry(void *pvParameters);
 	void taskLoop();
+    void wake();                          // 通知 LampTask 退出空闲阻塞
+    bool isAnimating() const;             // 是否需要帧时钟 (渐变/特效)
+    TickType_t idleWaitTicks() const;     // 空闲阻塞上限 (等待延迟提交/慢速渐变的下一次输出变化)
 	
-    bool advanceFade(uint32_t &elapsed_ms, uint8_t &start_brightness);
-    bool advanceColorFade(uint32_t &elapsed_ms); // 颜色渐变步进
-
-    // 应用曲线 (输入输出均为 Q16 定点数: 0..65535)
-    uint32_t applyEasing(uint32_t t_q16) const;
+    void advanceTweens(uint32_t dt_us);   // 渐变引擎步进并写回亮度/色温/RGB
+    void scheduleTweens();                // 判断渐变是否慢到可以休眠到下一次输出变化 (m_tweenSleep)
+    static bool tweenOutputChanged(void* ctx, uint8_t key, int32_t from, int32_t to);
+    void startRGBTween(const CRGB &target, uint32_t fade_ms); // 从 m_rgbColor 渐变到 target (m_colorSpace 中插值)
+    void cancelColorTweens();
+    void startCCTFade(uint16_t cct, uint32_t fade_ms);        // 切换/渐变到色温 (不发事件、不标脏)
+    void startColorFade(const CRGB &target, uint32_t fade_ms); // 切换/渐变到 RGB (不发事件、不标脏)
 
     // 状态变量
-	CRGB m_leds[LAMP_NUM_LEDS];
-	uint8_t m_brightness = 50;
+	CRGB m_leds[LAMP_NUM_LEDS];        // 后缓冲：持锁合成
+    CRGB m_frontLeds[LAMP_NUM_LEDS];   // 前缓冲：注册给 FastLED，仅 LampTask 在锁外输出
+    bool m_framePending = false;       // 前缓冲已更新、尚未 show()
+    uint32_t m_framesShown = 0;
+    uint32_t m_framesSkipped = 0;
+    LampLockStats m_lockStats{};
+    void recordLockHold(uint32_t us);
+    // 缩放表两槽缓存：抖动时在相邻两个 PWM 之间切换，不必每帧重建
+    uint8_t m_scaleLut[2][256];
+    uint16_t m_scaleLutPwm[2] = {0xFFFF, 0xFFFF}; // 0xFFFF = 缓存无效
+    uint8_t m_scaleLutNext = 0;                   // 下次替换的槽
+
+	uint8_t m_brightness = 50;                 // 逻辑亮度 0-100 (m_brightnessQ16 四舍五入)
+    uint32_t m_brightnessQ16 = 50u << 16;      // 逻辑亮度 Q16，渐变全程使用
+    uint8_t m_ditherAcc = 0;                   // sigma-delta 误差累加 (PWM 的 1/256)
 	uint16_t m_cct = 4000;
+    CctCalibration m_cctCal = CctCalibration::identity();
+    CRGB m_cctRgb;                 // m_cctRgbK 对应的校准后 RGB (cctToRawRGB 缓存)
+    uint16_t m_cctRgbK = 0;        // 0 = 缓存无效
     CRGB m_rgbColor = CRGB::White; // RGB 模式下的基色
     bool m_useCCT = true;          // true=CCT模式, false=RGB模式
 	
-    // 亮度渐变相关
-    volatile bool m_fadeActive = false;
-	uint8_t m_targetBrightness = 50;
-	uint16_t m_fadeDurationMs = 0;
+    // 渐变 (亮度/色温/RGB 各占一条轨道，见 lamp_tween.hpp)
+    TweenEngine m_tween;
     FadeCurve m_curve = FadeCurve::Linear;
-
-    // 颜色渐变相关
-    volatile bool m_colorFadeActive = false;
-    uint16_t m_colorFadeDurationMs = 0;
-    uint16_t m_startCCT = 0;
-    uint16_t m_targetCCT = 0;
-    CRGB m_startRGB;
-    CRGB m_targetRGB;
+    ColorSpace m_colorSpace = ColorSpace::Linear;
+    ColorFade m_colorFade;      // TWEEN_COLOR 进度 -> m_rgbColor
+    uint16_t m_targetCCT = 0;   // RGB -> CCT 渐变结束后切换到的色温
     bool m_fadingToCCT = false; // 标记是否正在从 RGB 渐变回 CCT 模式
 
-    // 特效状态
+    // 特效状态 (底层，即图层 0)
     EffectMode m_effect = EffectMode::None;
-    uint32_t m_effectTick = 0;
-    void runEffect(); // 执行特效逻辑
+    uint32_t m_effectMs = 0;    // 特效时间轴 (ms)，切换特效时清零
+    uint16_t m_effectUsRem = 0; // 不足 1ms 的余量
+    void runEffect(uint32_t dt_us); // 合成并提交一帧，dt_us 为距上一帧的实际时间
+
+    // 图层合成 (lamp_effects.cpp)
+    struct EffectLayer {
+        EffectMode mode = EffectMode::None;
+        BlendMode blend = BlendMode::Add;
+        uint8_t alpha = 255;
+        uint32_t ms = 0;      // 图层自身的时间轴
+        uint16_t usRem = 0;
+    };
+    EffectLayer m_overlays[MAX_LAYERS - 1];           // 图层 1 .. MAX_LAYERS-1
+    EffectLayer m_xfadeFrom;                          // 交叉淡化中正在淡出的旧底层
+    uint8_t m_xfadeAlpha = 255;                       // 新底层权重，255 = 未在淡化
+    CRGB m_layerBuf[MAX_LAYERS][LAMP_NUM_LEDS];       // [0] 淡出底层，[k] 叠加层 k (静态分配)
+    bool isCompositing() const;                       // 是否需要逐帧合成 (特效/叠加层/交叉淡化)
+    CRGB baseColor();                                 // 当前 CCT/RGB 基色 (未缩放)
+    const CRGB* effectPalette(EffectMode mode);       // 特效当前调色板的 256 项表
+
+    // 每种特效的参数 (调色板 Solid = 使用基色)
+    EffectParams m_effectParams[EFFECT_MODE_COUNT] = {
+        {128, 128, PaletteId::Solid, 0},   // None
+        {128, 128, PaletteId::Rainbow, 0}, // Rainbow
+        {128, 128, PaletteId::Solid, 0},   // Breathing
+        {128, 128, PaletteId::Solid, 0},   // Police (固定红蓝)
+        {128, 128, PaletteId::Solid, 0},   // Night
+        {128, 128, PaletteId::Solid, 0},   // Reading
+        {128, 128, PaletteId::Rainbow, 0}, // Spin
+        {128, 128, PaletteId::Solid, 0},   // Meteor
+        {128, 128, PaletteId::Fire, 0},    // Fire
+        {128, 128, PaletteId::Candle, 0},  // Candle
+        {128, 128, PaletteId::Aurora, 0},  // Aurora
+        {128, 128, PaletteId::Solid, 0},   // Image
+        {128, 128, PaletteId::Solid, 0},   // Animation (speed = 播放倍速)
+    };
+    PaletteCache m_palettes;
+
+    // 分区 (lamp_zones.cpp)
+    struct Zone {
+        bool on = true;
+        uint8_t level = 100;             // 目标亮度 (相对整灯)
+        uint32_t levelQ16 = 100u << 16;  // 当前有效亮度 (关闭时渐变到 0)
+        uint8_t ditherAcc = 0;
+        bool follow = true;              // true = 使用整灯颜色
+        bool releasing = false;          // 正在渐变回整灯颜色，结束后置 follow
+        bool cctMode = true;             // 覆盖色的来源 (仅用于状态上报)
+        uint16_t cct = 4000;
+        CRGB target;                     // 覆盖色目标值
+        CRGB color;                      // 当前覆盖色 (渐变中逐帧更新)
+        ColorFade fade;                  // TWEEN_ZONE_COLOR + zone 进度 -> color
+    };
+    Zone m_zones[LAMP_NUM_ZONES];
+    bool m_zonesUniform = true;          // 所有分区均为默认状态：走整灯单色/单表快速路径
+    void refreshZonesUniform();
+    uint32_t zoneBrightnessQ16(const Zone &z) const; // 整灯亮度 x 分区亮度
+    void startZoneColor(uint8_t zone, const CRGB &from, const CRGB &to, uint32_t fade_ms);
+    void finishZoneTweens();             // 渐变结束后的收尾 (回到整灯颜色)
+    void renderZones();                  // 静态模式：每个分区整块填色
+    void saveZonesToNVS();
+    void loadZonesFromNVS();
+
+    void renderEffect(EffectMode mode, uint32_t ms, CRGB* out); // 按时间轴绘制一层 (满亮度)
+
+    // Image / Animation 特效 (lamp_image.cpp)
+    CRGB m_image[LAMP_NUM_LEDS];         // 静止画面 (满亮度)
+    AnimReader m_anim;                   // 正在播放的动画文件；未打开 = 无动画 (黑)
+    CRGB m_animFrame[LAMP_NUM_LEDS];     // 动画当前帧 (增量解码的基准)
+    uint32_t m_animFrameEndMs = 0;       // 当前帧在特效时间轴上的结束时刻
+    bool handleAnimUpload(FrameOp op, const uint8_t* body, size_t len, uint8_t source); // 持 m_uploadMutex
+    void beginAnimation();               // 选择 Animation 特效时：从第一帧开始
+    bool readAnimFrame();                // 解码下一帧到 m_animFrame，文件末尾时回到开头
+    void renderAnimation(uint32_t ms, CRGB* out);
+
+    // 实时像素流 (lamp_stream.cpp)：m_leds 保存未缩放的流像素，缩放后直接写入前缓冲
+    bool m_streamActive = false;
+    bool m_streamPending = false;        // 有完整的新帧待输出
+    uint32_t m_streamLastMs = 0;         // 最近一次收包时刻
+    uint32_t m_streamRxUs = 0;           // 待输出帧的收包时刻
+    uint32_t m_frontRxUs = 0;            // 前缓冲中流帧的收包时刻 (0 = 非流帧)
+    LampStreamStats m_streamStats{};
+    bool serviceStream();                // LampTask：输出新帧或处理超时，返回 true 表示本帧由流占用
+    void stopStream();
 
     // 逻辑状态与记忆
 	bool m_on = false; 
 	uint8_t m_savedOnBrightness = 50;
 	TaskHandle_t m_taskHandle = nullptr;
-	static constexpr uint16_t STEP_MS = 10;
+	static constexpr uint16_t STEP_MS = 10;           // 默认帧间隔 (100fps)
+    static constexpr uint16_t REDUCED_STEP_MS = 40;   // 降帧间隔 (25fps)
+    static constexpr uint32_t MAX_FRAME_US = 250000;  // 单帧时间步长上限，防止长时间阻塞后跳变
+    uint16_t m_frameMs = STEP_MS;
+    uint16_t m_tweenUsRem = 0;  // 渐变时钟不足 1ms 的余量
+
+    // 慢速渐变调度：静态模式下输出超过 TWEEN_SLEEP_MIN_MS 才变化一次时，LampTask 不走帧时钟，
+    // 休眠到下一次变化 (最长 TWEEN_MAX_SLEEP_MS)；期间按四舍五入 PWM 输出，不做 sigma-delta 抖动
+    static constexpr uint32_t TWEEN_SLEEP_MIN_MS = 100;
+    static constexpr uint32_t TWEEN_MAX_SLEEP_MS = 60000;
+    bool m_tweenSleep = false;
+    uint32_t m_tweenWaitMs = 0;  // 距下一次输出变化 (m_tweenSleep 时有效)
 
     // 延迟提交相关
     static constexpr uint32_t COMMIT_DELAY_MS = 1000; 
     
-    // 线程安全
+    // 线程安全：m_mutex 由 LampTask 持有 (实时流接收任务收包时短暂持有)；其他任务经 m_cmdQueue 投递命令
     SemaphoreHandle_t m_mutex = nullptr;
+    SemaphoreHandle_t m_uploadMutex = nullptr; // 动画上传状态 (BLE / MQTT 任务)
+    QueueHandle_t m_cmdQueue = nullptr;
+    static constexpr UBaseType_t CMD_QUEUE_LEN = 16;
+
+    // 状态快照 (seqlock：序号为奇数表示写入中)
+    LampStateSnapshot m_snapshot{};
+    std::atomic<uint32_t> m_stateSeq{0};
 
     // 内部辅助：加载/保存状态
     void loadStateFromNVS();
     void markChanged();
     void flushIfIdle();
+    bool hasPendingFlush() const;
 
 	void saveOnToNVS();
 	void saveSavedBrightnessToNVS();
 	void saveCCTToNVS();
     void saveRGBToNVS();
     void saveModeToNVS();
+    void saveEffectParamsToNVS();
+    void saveCctCalibrationToNVS();
+    void saveScenesToNVS();
     
     // 脏标记
     bool m_dirty_on = false;
@@ -171,6 +521,10 @@ private:
     bool m_dirty_rgb = false;
     bool m_dirty_mode = false;
     bool m_dirty_auto_br = false;
+    bool m_dirty_fx = false;
+    bool m_dirty_cal = false;
+    bool m_dirty_scenes = false;
+    bool m_dirty_zones = false;
     uint32_t m_lastChangeMs = 0;
 
     // 自动亮度
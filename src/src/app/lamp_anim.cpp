@@ -0,0 +1,178 @@
+#include "lamp_anim.hpp"
+#include <string.h>
+
+// =================================================================================
+// 动画文件：增量游程编码 / 流式读取
+// =================================================================================
+
+namespace {
+
+constexpr uint8_t kMagic[4] = {'L', 'A', 'N', 'M'};
+
+constexpr uint8_t OP_SKIP = 0x00;    // 0x00-0x7F
+constexpr uint8_t OP_LITERAL = 0x80; // 0x80-0xBF
+constexpr uint8_t OP_REPEAT = 0xC0;  // 0xC0-0xFF
+constexpr uint8_t kMaxSkip = 128;
+constexpr uint8_t kMaxRun = 64;
+
+} // namespace
+
+void anim_make_header(uint8_t* out, uint16_t frameCount) {
+    memcpy(out, kMagic, sizeof(kMagic));
+    out[4] = ANIM_VERSION;
+    out[5] = FRAME_PIXELS;
+    out[6] = (uint8_t)(frameCount & 0xFF);
+    out[7] = (uint8_t)(frameCount >> 8);
+}
+
+/**
+ * @brief 贪心编码：不变像素合并为跳过，连续同色 (>= 2) 用重复，其余并入逐像素段
+ */
+size_t anim_encode_delta(const CRGB* prev, const CRGB* cur, uint8_t* out, size_t cap) {
+    size_t n = 0;
+    uint8_t i = 0;
+    while (i < FRAME_PIXELS) {
+        if (cur[i] == prev[i]) {
+            uint8_t run = 1;
+            while (i + run < FRAME_PIXELS && run < kMaxSkip && cur[i + run] == prev[i + run]) run++;
+            if (n + 1 > cap) return 0;
+            out[n++] = (uint8_t)(OP_SKIP | (run - 1));
+            i += run;
+            continue;
+        }
+
+        uint8_t same = 1;
+        while (i + same < FRAME_PIXELS && same < kMaxRun && cur[i + same] == cur[i]) same++;
+        if (same >= 2) {
+            if (n + 4 > cap) return 0;
+            out[n++] = (uint8_t)(OP_REPEAT | (same - 1));
+            out[n++] = cur[i].r;
+            out[n++] = cur[i].g;
+            out[n++] = cur[i].b;
+            i += same;
+            continue;
+        }
+
+        // 逐像素段：遇到不变像素或同色游程的起点时结束
+        uint8_t lit = 1;
+        while (i + lit < FRAME_PIXELS && lit < kMaxRun) {
+            const uint8_t k = i + lit;
+            if (cur[k] == prev[k]) break;
+            if (k + 1 < FRAME_PIXELS && cur[k + 1] == cur[k]) break;
+            lit++;
+        }
+        if (n + 1 + (size_t)lit * 3 > cap) return 0;
+        out[n++] = (uint8_t)(OP_LITERAL | (lit - 1));
+        for (uint8_t k = 0; k < lit; k++) {
+            out[n++] = cur[i + k].r;
+            out[n++] = cur[i + k].g;
+            out[n++] = cur[i + k].b;
+        }
+        i += lit;
+    }
+    return n;
+}
+
+// =================================================================================
+// AnimReader
+// =================================================================================
+
+bool AnimReader::open(fs::FS &fs, const char* path) {
+    close();
+    m_file = fs.open(path, "r");
+    if (!m_file) return false;
+
+    uint8_t hdr[ANIM_HEADER_SIZE];
+    if (m_file.read(hdr, sizeof(hdr)) != sizeof(hdr) ||
+        memcmp(hdr, kMagic, sizeof(kMagic)) != 0 ||
+        hdr[4] != ANIM_VERSION || hdr[5] != FRAME_PIXELS) {
+        close();
+        return false;
+    }
+    m_frameCount = (uint16_t)(hdr[6] | (hdr[7] << 8));
+    if (m_frameCount == 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AnimReader::close() {
+    m_file.close();
+    m_frameCount = 0;
+    m_pos = m_len = 0;
+}
+
+bool AnimReader::rewind() {
+    m_pos = m_len = 0;
+    return m_file && m_file.seek(ANIM_HEADER_SIZE);
+}
+
+bool AnimReader::fill() {
+    m_pos = 0;
+    m_len = (uint8_t)m_file.read(m_buf, sizeof(m_buf));
+    return m_len > 0;
+}
+
+int AnimReader::next() {
+    if (m_pos >= m_len && !fill()) return -1;
+    return m_buf[m_pos++];
+}
+
+bool AnimReader::take(uint8_t* dst, size_t n) {
+    while (n > 0) {
+        if (m_pos >= m_len && !fill()) return false;
+        size_t chunk = m_len - m_pos;
+        if (chunk > n) chunk = n;
+        memcpy(dst, m_buf + m_pos, chunk);
+        m_pos += chunk;
+        dst += chunk;
+        n -= chunk;
+    }
+    return true;
+}
+
+/**
+ * @brief 解码下一帧
+ *
+ * 操作直接作用于 px；格式错误时 px 可能只更新了一部分，调用方应停止播放。
+ */
+AnimReader::Result AnimReader::readFrame(CRGB* px, uint16_t &durMs) {
+    uint8_t hdr[ANIM_FRAME_HEADER_SIZE];
+    if (m_pos >= m_len && !fill()) return Result::End;
+    if (!take(hdr, sizeof(hdr))) return Result::Corrupt;
+    durMs = (uint16_t)(hdr[0] | (hdr[1] << 8));
+    const uint16_t len = (uint16_t)(hdr[2] | (hdr[3] << 8));
+    if (len == 0 || len > ANIM_MAX_FRAME_BYTES) return Result::Corrupt;
+
+    uint16_t used = 0;
+    uint8_t i = 0;
+    while (used < len) {
+        const int op = next();
+        if (op < 0) return Result::Corrupt;
+        used++;
+
+        if (op < OP_LITERAL) {
+            const uint8_t run = (uint8_t)(op - OP_SKIP + 1);
+            if (run > FRAME_PIXELS - i) return Result::Corrupt;
+            i += run;
+        } else if (op < OP_REPEAT) {
+            const uint8_t run = (uint8_t)(op - OP_LITERAL + 1);
+            if (run > FRAME_PIXELS - i || used + run * 3 > len) return Result::Corrupt;
+            for (uint8_t k = 0; k < run; k++) {
+                uint8_t rgb[3];
+                if (!take(rgb, sizeof(rgb))) return Result::Corrupt;
+                px[i++] = CRGB(rgb[0], rgb[1], rgb[2]);
+            }
+            used += run * 3;
+        } else {
+            const uint8_t run = (uint8_t)(op - OP_REPEAT + 1);
+            uint8_t rgb[3];
+            if (run > FRAME_PIXELS - i || used + 3 > len || !take(rgb, sizeof(rgb))) return Result::Corrupt;
+            fill_solid(px + i, run, CRGB(rgb[0], rgb[1], rgb[2]));
+            i += run;
+            used += 3;
+        }
+    }
+    return i == FRAME_PIXELS ? Result::Ok : Result::Corrupt;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <FastLED.h>
+#include <FS.h>
+#include "lamp_frame.hpp"
+
+// =================================================================================
+// 动画文件格式 (文件存储中的 .lanm，逐帧流式播放)
+// =================================================================================
+//
+//   文件头 8 字节：'L' 'A' 'N' 'M' [版本 1][像素数 64][帧数 低][高]
+//   每帧：         [时长 ms 低][高][长度 低][高][操作...]
+//
+// 每帧相对上一帧做增量游程编码 (第一帧相对全黑)，操作依次覆盖 FRAME_PIXELS 个像素：
+//   0x00-0x7F  跳过 n+1 个像素 (与上一帧相同)
+//   0x80-0xBF  随后 n-0x7F 个像素逐个给出 r,g,b
+//   0xC0-0xFF  随后一组 r,g,b 重复 n-0xBF 个像素
+//
+// 不变的区域只占 1 字节 (整帧不变的帧共 5 字节)；最坏情况 (全部像素各不相同) 每帧 193 字节。
+
+static constexpr uint8_t ANIM_VERSION = 1;
+static constexpr size_t ANIM_HEADER_SIZE = 8;
+static constexpr size_t ANIM_FRAME_COUNT_OFFSET = 6;
+static constexpr size_t ANIM_FRAME_HEADER_SIZE = 4;
+static constexpr size_t ANIM_MAX_FRAME_BYTES = 256; // 单帧操作数据上限 (编码器输出不会超过)
+
+/**
+ * @brief 把一帧编码为相对上一帧的增量操作
+ *
+ * @return 写入 out 的字节数；cap 不足时返回 0
+ */
+size_t anim_encode_delta(const CRGB* prev, const CRGB* cur, uint8_t* out, size_t cap);
+
+/**
+ * @brief 生成文件头 (帧数可在上传结束后于 ANIM_FRAME_COUNT_OFFSET 处回填)
+ */
+void anim_make_header(uint8_t* out, uint16_t frameCount);
+
+/**
+ * @brief 动画文件流式读取器
+ *
+ * 只持有文件句柄和一小段预读缓冲，每次把一帧的增量直接解码进调用方的像素缓冲 (上一帧)，
+ * 不把整个文件载入内存。读到文件末尾时由调用方 rewind() 并清黑像素缓冲后从第一帧重来。
+ */
+class AnimReader {
+public:
+    static constexpr size_t READ_AHEAD = 64;
+
+    bool open(fs::FS &fs, const char* path); // 校验文件头并定位到第一帧
+    void close();
+    bool rewind();                           // 回到第一帧 (调用方须把像素缓冲清黑)
+    explicit operator bool() const { return (bool)m_file; }
+    uint16_t frameCount() const { return m_frameCount; }
+
+    enum class Result : uint8_t { Ok, End, Corrupt };
+    // 把下一帧解码进 px (上一帧内容)，durMs 返回该帧时长
+    Result readFrame(CRGB* px, uint16_t &durMs);
+
+private:
+    File m_file;
+    uint16_t m_frameCount = 0;
+    uint8_t m_buf[READ_AHEAD];
+    uint8_t m_pos = 0;
+    uint8_t m_len = 0;
+
+    bool fill();
+    int next();                                   // 读取 1 字节，文件末尾返回 -1
+    bool take(uint8_t* dst, size_t n);            // 读取 n 字节
+};
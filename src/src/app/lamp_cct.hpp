@@ -0,0 +1,134 @@
+#pragma once
+#include <stdint.h>
+#include <FastLED.h>
+#include "lamp_color.hpp"
+
+// =================================================================================
+// 色温 -> RGB (普朗克轨迹)
+// =================================================================================
+//
+// 编译期沿普朗克轨迹每 50K 采样一次 (2700-6500K，77 项)：
+// 色温 -> CIE 1931 xy (Kim et al. 三次样条近似) -> XYZ -> 线性 sRGB，最大通道归一化为 65535。
+// 插值与校准矩阵都须在线性光中进行，因此表中保存线性光。
+//
+// 运行时：相邻两项线性插值 -> 每台设备的 3x3 校准矩阵 (Q12) -> 归一化 -> sRGB 编码到 8 位。
+// 输出与其余 CRGB (用户 RGB、调色板、ColorFade 端点) 一样是 sRGB Gamma 编码值，
+// RGB <-> CCT 渐变解码端点时不会被二次线性化。
+// 结果由 LampController 按色温缓存，特效循环只读缓存。
+
+static constexpr uint16_t kCctMinK = 2700;
+static constexpr uint16_t kCctMaxK = 6500;
+static constexpr uint16_t kCctStepK = 50;
+static constexpr uint16_t kCctTableSize = (kCctMaxK - kCctMinK) / kCctStepK + 1;
+
+static_assert((kCctMaxK - kCctMinK) % kCctStepK == 0, "色温范围须为采样间隔的整数倍");
+
+namespace cct_detail {
+
+struct Rgb16 {
+    uint16_t r, g, b;
+};
+
+struct CctTable {
+    Rgb16 v[kCctTableSize];
+};
+
+// 普朗克轨迹色度坐标 (Kim et al. 2002，1667-25000K)
+constexpr void planck_xy(double t, double &x, double &y) {
+    const double t2 = t * t, t3 = t2 * t;
+    if (t <= 4000) {
+        x = -0.2661239e9 / t3 - 0.2343589e6 / t2 + 0.8776956e3 / t + 0.179910;
+    } else {
+        x = -3.0258469e9 / t3 + 2.1070379e6 / t2 + 0.2226347e3 / t + 0.240390;
+    }
+    const double x2 = x * x, x3 = x2 * x;
+    if (t <= 2222) {
+        y = -1.1063814 * x3 - 1.34811020 * x2 + 2.18555832 * x - 0.20219683;
+    } else if (t <= 4000) {
+        y = -0.9549476 * x3 - 1.37418593 * x2 + 2.09137015 * x - 0.16748867;
+    } else {
+        y = 3.0817580 * x3 - 5.87338670 * x2 + 3.75112997 * x - 0.37001483;
+    }
+}
+
+constexpr Rgb16 planck_rgb(double t) {
+    double x = 0, y = 0;
+    planck_xy(t, x, y);
+    const double X = x / y, Y = 1.0, Z = (1 - x - y) / y;
+
+    double r = 3.2404542 * X - 1.5371385 * Y - 0.4985314 * Z;
+    double g = -0.9692660 * X + 1.8760108 * Y + 0.0415560 * Z;
+    double b = 0.0556434 * X - 0.2040259 * Y + 1.0572252 * Z;
+    if (r < 0) r = 0;
+    if (g < 0) g = 0;
+    if (b < 0) b = 0;
+
+    double m = r > g ? r : g;
+    if (b > m) m = b;
+    return Rgb16{(uint16_t)(r / m * 65535 + 0.5), (uint16_t)(g / m * 65535 + 0.5), (uint16_t)(b / m * 65535 + 0.5)};
+}
+
+constexpr CctTable makeCctTable() {
+    CctTable t{};
+    for (uint16_t i = 0; i < kCctTableSize; i++) t.v[i] = planck_rgb(kCctMinK + i * kCctStepK);
+    return t;
+}
+
+inline constexpr CctTable kCctTable = makeCctTable();
+
+} // namespace cct_detail
+
+/**
+ * @brief 每台设备的白点校准矩阵 (Q12，4096 = 1.0)
+ *
+ * 作用于线性 RGB：out = M * in。用于补偿 LED 批次之间的色偏。
+ * 系数限制在 [-2.0, 2.0]，保证 cct_to_rgb() 中的 Q16 * Q12 累加不溢出。
+ */
+struct CctCalibration {
+    int16_t m[9];
+
+    static constexpr int16_t kOne = 4096;
+    static constexpr int16_t kLimit = 2 * kOne;
+    static constexpr CctCalibration identity() {
+        return CctCalibration{{kOne, 0, 0, 0, kOne, 0, 0, 0, kOne}};
+    }
+};
+
+/**
+ * @brief 色温 -> 校准后的 8 位 sRGB (最大通道为 255)
+ *
+ * @param cct 色温 K，超出范围时钳位
+ */
+inline CRGB cct_to_rgb(uint16_t cct, const CctCalibration &cal) {
+    using namespace cct_detail;
+    if (cct < kCctMinK) cct = kCctMinK;
+    if (cct > kCctMaxK) cct = kCctMaxK;
+
+    const uint16_t pos = cct - kCctMinK;
+    const uint16_t idx = pos / kCctStepK;
+    const uint32_t frac = pos % kCctStepK; // 0..49
+    const Rgb16 &a = kCctTable.v[idx];
+    const Rgb16 &b = kCctTable.v[idx + 1 < kCctTableSize ? idx + 1 : idx];
+
+    const int32_t in[3] = {
+        (int32_t)(a.r + (((int32_t)b.r - a.r) * (int32_t)frac) / kCctStepK),
+        (int32_t)(a.g + (((int32_t)b.g - a.g) * (int32_t)frac) / kCctStepK),
+        (int32_t)(a.b + (((int32_t)b.b - a.b) * (int32_t)frac) / kCctStepK),
+    };
+
+    // Q16 * Q12：|系数| <= kLimit，三项之和不超出 int32
+    int32_t out[3];
+    int32_t peak = 0;
+    for (uint8_t c = 0; c < 3; c++) {
+        int32_t v = (cal.m[c * 3] * in[0] + cal.m[c * 3 + 1] * in[1] + cal.m[c * 3 + 2] * in[2]) >> 12;
+        if (v < 0) v = 0;
+        out[c] = v;
+        if (v > peak) peak = v;
+    }
+    if (peak == 0) return CRGB::Black;
+
+    // 线性 Q16 (最大通道 65535) -> sRGB 字节 (与 ColorFade 共用同一张转换表)
+    return CRGB(color_from_linear((uint16_t)(((int64_t)out[0] * 65535 + peak / 2) / peak)),
+                color_from_linear((uint16_t)(((int64_t)out[1] * 65535 + peak / 2) / peak)),
+                color_from_linear((uint16_t)(((int64_t)out[2] * 65535 + peak / 2) / peak)));
+}
@@ -0,0 +1,198 @@
+#pragma once
+#include <stdint.h>
+#include <FastLED.h>
+
+// =================================================================================
+// 感知均匀的颜色渐变 (线性光 / OKLab)
+// =================================================================================
+//
+// CRGB 字节是 sRGB Gamma 编码值，直接逐字节插值时中间色偏暗、偏灰。
+// 这里把渐变端点转换到线性光 (Q16) 或 OKLab 后再插值，每步再转换回 sRGB。
+//
+// - sRGB -> 线性：编译期生成的 256 项表 (512 字节)；
+// - 线性 -> sRGB：在同一张表上二分查找最近项 (8 次比较)，不需要第二张表；
+// - OKLab：Lab 与立方根后的 LMS (l', m', s') 是线性关系，插值 Lab 等价于插值 l'm's'，
+//   因此每步只需 l'm's' 插值 -> 立方 (整数乘法) -> 3x3 矩阵 -> 查表。
+//   立方根只在渐变开始时对两个端点各求一次。
+//
+// 每步全部为 32 位整数运算，适合 100Hz 帧率。
+
+// 颜色渐变插值空间
+enum class ColorSpace : uint8_t {
+    Gamma,   // 直接插值 sRGB 字节 (旧行为)
+    Linear,  // 线性光
+    OKLab    // 感知均匀，色相过渡最自然
+};
+
+namespace color_detail {
+
+// 编译期五次方根 (Newton 迭代)，a 在 (0, 1]
+constexpr double ct_root5(double a) {
+    double r = 1.0;
+    for (int i = 0; i < 40; i++) {
+        const double r4 = r * r * r * r;
+        r = (4 * r + a / r4) / 5;
+    }
+    return r;
+}
+
+// sRGB 解码：x <= 0.04045 为线性段，否则 ((x + 0.055) / 1.055)^2.4
+constexpr double ct_srgb_to_linear(double x) {
+    if (x <= 0.04045) return x / 12.92;
+    const double y = (x + 0.055) / 1.055;
+    return y * y * ct_root5(y * y); // y^2.4 = y^2 * (y^2)^(1/5)
+}
+
+struct LinearTable {
+    uint16_t v[256];
+};
+
+constexpr LinearTable makeLinearTable() {
+    LinearTable t{};
+    for (int i = 0; i < 256; i++) {
+        t.v[i] = (uint16_t)(ct_srgb_to_linear(i / 255.0) * 65535 + 0.5);
+    }
+    return t;
+}
+
+inline constexpr LinearTable kToLinear = makeLinearTable();
+
+static_assert(kToLinear.v[0] == 0 && kToLinear.v[255] == 65535, "sRGB 表端点");
+
+constexpr int32_t q12(double v) {
+    return (int32_t)(v * 4096 + (v >= 0 ? 0.5 : -0.5));
+}
+
+constexpr int32_t q14(double v) {
+    return (int32_t)(v * 16384 + (v >= 0 ? 0.5 : -0.5));
+}
+
+// 线性 sRGB -> LMS (Q14，每行之和为 1)
+inline constexpr int32_t kM1[3][3] = {
+    {q14(0.4122214708), q14(0.5363325363), q14(0.0514459929)},
+    {q14(0.2119034982), q14(0.6806995451), q14(0.1073969566)},
+    {q14(0.0883024619), q14(0.2817188376), q14(0.6299787005)},
+};
+
+// LMS -> 线性 sRGB (Q12；|系数| 之和 < 8，乘 65535 后不超出 int32)
+inline constexpr int32_t kM2[3][3] = {
+    {q12( 4.0767416621), q12(-3.3077115913), q12( 0.2309699292)},
+    {q12(-1.2684380046), q12( 2.6097574011), q12(-0.3413193965)},
+    {q12(-0.0041960863), q12(-0.7034186147), q12( 1.7076147010)},
+};
+
+/**
+ * @brief Q16 立方根 (二分，16 次迭代)，仅在渐变开始时调用
+ */
+inline int32_t cbrt_q16(uint32_t x) {
+    const uint64_t target = (uint64_t)x << 32;
+    uint32_t lo = 0, hi = 65536;
+    while (hi - lo > 1) {
+        const uint32_t mid = (lo + hi) >> 1;
+        if ((uint64_t)mid * mid * mid <= target) lo = mid;
+        else hi = mid;
+    }
+    return (int32_t)lo;
+}
+
+inline uint16_t clamp_q16(int32_t v) {
+    return v < 0 ? 0 : (v > 65535 ? 65535 : (uint16_t)v);
+}
+
+} // namespace color_detail
+
+/** @brief sRGB 字节 -> 线性光 Q16 */
+inline uint16_t color_to_linear(uint8_t v) {
+    return color_detail::kToLinear.v[v];
+}
+
+/** @brief 线性光 Q16 -> 最接近的 sRGB 字节 */
+inline uint8_t color_from_linear(uint16_t lin) {
+    const uint16_t* t = color_detail::kToLinear.v;
+    uint8_t lo = 0;
+    for (uint8_t step = 128; step; step >>= 1) {
+        if (t[lo + step] <= lin) lo += step;
+    }
+    if (lo < 255 && (uint32_t)(t[lo + 1] - lin) < (uint32_t)(lin - t[lo])) lo++;
+    return lo;
+}
+
+/**
+ * @brief 两个 CRGB 之间的渐变插值器
+ *
+ * begin() 把端点转换到插值空间，at() 按进度 (Q16，0-65536) 求中间色。
+ * 端点原样返回，不受往返转换误差影响。
+ */
+class ColorFade {
+public:
+    void begin(ColorSpace space, const CRGB &from, const CRGB &to) {
+        m_space = space;
+        m_from = from;
+        m_to = to;
+        for (uint8_t c = 0; c < 3; c++) {
+            m_a[c] = toSpace(from, c);
+            m_b[c] = toSpace(to, c);
+        }
+    }
+
+    CRGB at(uint32_t p) const {
+        if (p == 0) return m_from;
+        if (p >= 65536) return m_to;
+
+        int32_t v[3];
+        for (uint8_t c = 0; c < 3; c++) {
+            v[c] = m_a[c] + (int32_t)(((int64_t)(m_b[c] - m_a[c]) * (int32_t)p) >> 16);
+        }
+
+        switch (m_space) {
+            case ColorSpace::Gamma:
+                return CRGB((uint8_t)v[0], (uint8_t)v[1], (uint8_t)v[2]);
+            case ColorSpace::Linear:
+                return CRGB(color_from_linear((uint16_t)v[0]), color_from_linear((uint16_t)v[1]),
+                            color_from_linear((uint16_t)v[2]));
+            case ColorSpace::OKLab:
+            default: {
+                // l'm's' -> LMS (立方) -> 线性 sRGB
+                using namespace color_detail;
+                uint32_t lms[3];
+                for (uint8_t c = 0; c < 3; c++) {
+                    const uint32_t x = clamp_q16(v[c]);
+                    lms[c] = ((x * x) >> 16) * x >> 16;
+                }
+                CRGB out;
+                for (uint8_t c = 0; c < 3; c++) {
+                    const int32_t lin = (kM2[c][0] * (int32_t)lms[0] + kM2[c][1] * (int32_t)lms[1] +
+                                         kM2[c][2] * (int32_t)lms[2]) >> 12;
+                    out.raw[c] = color_from_linear(clamp_q16(lin));
+                }
+                return out;
+            }
+        }
+    }
+
+    const CRGB &target() const { return m_to; }
+
+private:
+    // 端点在插值空间中的第 c 个分量
+    int32_t toSpace(const CRGB &rgb, uint8_t c) const {
+        using namespace color_detail;
+        switch (m_space) {
+            case ColorSpace::Gamma:
+                return rgb.raw[c];
+            case ColorSpace::Linear:
+                return color_to_linear(rgb.raw[c]);
+            case ColorSpace::OKLab:
+            default: {
+                const uint32_t lms = ((uint32_t)kM1[c][0] * color_to_linear(rgb.r) +
+                                      (uint32_t)kM1[c][1] * color_to_linear(rgb.g) +
+                                      (uint32_t)kM1[c][2] * color_to_linear(rgb.b)) >> 14;
+                return cbrt_q16(lms > 65535 ? 65535 : lms);
+            }
+        }
+    }
+
+    ColorSpace m_space = ColorSpace::Linear;
+    CRGB m_from, m_to;
+    int32_t m_a[3] = {0, 0, 0};
+    int32_t m_b[3] = {0, 0, 0};
+};
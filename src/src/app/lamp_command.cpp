@@ -0,0 +1,569 @@
+#include "lamp.hpp"
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+// =================================================================================
+// 控制命令队列
+//
+// GUI / MQTT / BLE / 按键任务只把命令写入 m_cmdQueue (超时 0，不阻塞)，
+// LampTask 在每帧开头持锁取出并执行。调用方因此不会被 FastLED.show()
+// 期间持有的 m_mutex 挡住，也不会因优先级较低的 LampTask 而发生优先级反转。
+// =================================================================================
+
+/**
+ * @brief 投递一条命令并唤醒 LampTask
+ *
+ * @return false 表示队列已满，命令被丢弃
+ */
+bool LampController::post(const LampCommand &cmd) {
+    if (m_cmdQueue == nullptr) return false;
+
+    if (xQueueSend(m_cmdQueue, &cmd, 0) != pdTRUE) {
+        Serial.printf("[Lamp] Command queue full, dropped type=%u\n", (unsigned)cmd.type);
+        return false;
+    }
+    wake();
+    return true;
+}
+
+/**
+ * @brief 取出并执行全部待处理命令 (LampTask，已持有 m_mutex)
+ */
+void LampController::drainCommands() {
+    LampCommand cmd;
+    while (xQueueReceive(m_cmdQueue, &cmd, 0) == pdTRUE) {
+        applyCommand(cmd);
+    }
+}
+
+void LampController::applyCommand(const LampCommand &cmd) {
+    switch (cmd.type) {
+        case LampCommand::Type::Power:
+            applyPower(cmd.value != 0, cmd.fadeMs, cmd.excludeMask);
+            break;
+        case LampCommand::Type::TogglePower:
+            applyPower(!m_on, cmd.fadeMs, cmd.excludeMask);
+            break;
+        case LampCommand::Type::Brightness:
+            applyBrightness((uint8_t)cmd.value, cmd.fadeMs, cmd.excludeMask);
+            break;
+        case LampCommand::Type::SavedBrightness:
+            applySavedBrightness((uint8_t)cmd.value);
+            break;
+        case LampCommand::Type::CCT:
+            applyCCT(cmd.value, cmd.fadeMs, cmd.excludeMask);
+            break;
+        case LampCommand::Type::Color:
+            applyColor(cmd.r, cmd.g, cmd.b, cmd.fadeMs, cmd.excludeMask);
+            break;
+        case LampCommand::Type::Effect:
+            applyEffect((EffectMode)cmd.value, cmd.fadeMs);
+            break;
+        case LampCommand::Type::Overlay:
+            applyOverlay(cmd.r, (EffectMode)cmd.value, (BlendMode)cmd.g, cmd.b);
+            break;
+        case LampCommand::Type::EffectParams:
+            applyEffectParams(cmd.r == 0xFF ? m_effect : (EffectMode)cmd.r, cmd.params, cmd.g);
+            break;
+        case LampCommand::Type::CctCalibration:
+            applyCctCalibration(cmd.calibration);
+            break;
+        case LampCommand::Type::Scene:
+            applyScene(cmd.scene, cmd.excludeMask);
+            break;
+        case LampCommand::Type::SceneStore:
+            applySceneStore(cmd.sceneDef);
+            break;
+        case LampCommand::Type::SceneDelete:
+            applySceneDelete(cmd.scene);
+            break;
+        case LampCommand::Type::Zone:
+            applyZone(cmd.r, cmd.zone, cmd.g, cmd.fadeMs, cmd.excludeMask);
+            break;
+        case LampCommand::Type::AutoBrightness:
+            applyAutoBrightness(cmd.value != 0);
+            break;
+        case LampCommand::Type::ReducedFrameRate:
+            m_frameMs = cmd.value ? REDUCED_STEP_MS : STEP_MS;
+            break;
+    }
+}
+
+// =================================================================================
+// 公共控制接口 (生产者侧)
+// =================================================================================
+
+static LampCommand make_command(LampCommand::Type type, uint16_t value = 0,
+                                uint32_t fade_ms = 0, uint8_t excludeMask = 0) {
+    LampCommand cmd{};
+    cmd.type = type;
+    cmd.value = value;
+    cmd.fadeMs = fade_ms > LampController::MAX_FADE_MS ? LampController::MAX_FADE_MS : fade_ms;
+    cmd.excludeMask = excludeMask;
+    return cmd;
+}
+
+/**
+ * @brief 复制场景名到命令；超出 LampCommand::scene 容量时返回 false (与 scene_parse 一致，不截断)
+ */
+static bool copy_scene_name(LampCommand &cmd, const char* name) {
+    if (name == nullptr) return false;
+    const size_t len = strlen(name);
+    if (len >= sizeof(cmd.scene)) return false;
+    memcpy(cmd.scene, name, len + 1);
+    return true;
+}
+
+/**
+ * @brief 设置逻辑电源状态（带渐变）
+ * 
+ * @param on true=开灯, false=关灯
+ * @param fade_ms 渐变时间(ms)
+ */
+void LampController::setPower(bool on, uint32_t fade_ms, uint8_t excludeMask) {
+    post(make_command(LampCommand::Type::Power, on ? 1 : 0, fade_ms, excludeMask));
+}
+
+/**
+ * @brief 切换电源状态
+ *
+ * 开关判断推迟到 LampTask 执行，避免读取到尚未应用的旧状态。
+ */
+void LampController::togglePower(uint32_t fade_ms) {
+    post(make_command(LampCommand::Type::TogglePower, 0, fade_ms));
+}
+
+/**
+ * @brief 设置亮度
+ * 
+ * @param percent 用户输入的亮度 0-100
+ * @param fade_ms 渐变时间 (0 表示立即设置)，按给定时长执行，不随亮度差缩放
+ */
+void LampController::setBrightness(uint8_t percent, uint32_t fade_ms, uint8_t excludeMask) {
+    post(make_command(LampCommand::Type::Brightness, percent, fade_ms, excludeMask));
+}
+
+/**
+ * @brief 设置色温 (切换到 CCT 模式)
+ */
+void LampController::setCCT(uint16_t cct, uint32_t fade_ms, uint8_t excludeMask) {
+    post(make_command(LampCommand::Type::CCT, cct, fade_ms, excludeMask));
+}
+
+/**
+ * @brief 设置白点校准矩阵 (Q12，行优先)
+ */
+void LampController::setCctCalibration(const CctCalibration &cal) {
+    LampCommand cmd = make_command(LampCommand::Type::CctCalibration);
+    cmd.calibration = cal;
+    post(cmd);
+}
+
+/**
+ * @brief 设置白点校准矩阵 (文本形式，供 MQTT 使用)
+ *
+ * "1.0,0,0,0,0.92,0,0,0,0.85" (行优先，9 个系数) 或 "reset" 恢复单位矩阵。
+ * 系数超出 [-2, 2] 时钳位。
+ *
+ * @return false 表示格式错误或含 nan/inf
+ */
+bool LampController::setCctCalibration(const char* spec) {
+    if (spec == nullptr) return false;
+    if (strcasecmp(spec, "reset") == 0) {
+        setCctCalibration(CctCalibration::identity());
+        return true;
+    }
+
+    float f[9];
+    if (sscanf(spec, "%f,%f,%f,%f,%f,%f,%f,%f,%f",
+               &f[0], &f[1], &f[2], &f[3], &f[4], &f[5], &f[6], &f[7], &f[8]) != 9) {
+        return false;
+    }
+
+    // nan / inf 无法换算为 Q12 系数，整组拒绝，不写入 NVS
+    for (uint8_t i = 0; i < 9; i++) {
+        if (!isfinite(f[i])) return false;
+    }
+
+    CctCalibration cal;
+    const float limit = (float)CctCalibration::kLimit;
+    for (uint8_t i = 0; i < 9; i++) {
+        // 先在浮点域钳位，避免超大系数在 lroundf 中溢出
+        float v = f[i] * CctCalibration::kOne;
+        if (v > limit) v = limit;
+        if (v < -limit) v = -limit;
+        cal.m[i] = (int16_t)lroundf(v);
+    }
+    setCctCalibration(cal);
+    return true;
+}
+
+/**
+ * @brief 设置 RGB 颜色 (切换到 RGB 模式)
+ */
+void LampController::setColor(uint8_t r, uint8_t g, uint8_t b, uint32_t fade_ms, uint8_t excludeMask) {
+    LampCommand cmd = make_command(LampCommand::Type::Color, 0, fade_ms, excludeMask);
+    cmd.r = r;
+    cmd.g = g;
+    cmd.b = b;
+    post(cmd);
+}
+
+/**
+ * @brief 设置 HSV 颜色 (切换到 RGB 模式)
+ */
+void LampController::setHSV(uint8_t h, uint8_t s, uint8_t v, uint32_t fade_ms, uint8_t excludeMask) {
+    CRGB rgb;
+    rgb.setHSV(h, s, v);
+    setColor(rgb.r, rgb.g, rgb.b, fade_ms, excludeMask);
+}
+
+/**
+ * @brief 设置开灯记忆亮度
+ */
+void LampController::setSavedBrightness(uint8_t percent) {
+    post(make_command(LampCommand::Type::SavedBrightness, percent));
+}
+
+/**
+ * @brief 设置特效模式
+ *
+ * @param fade_ms 与当前特效交叉淡化的时长 (0 = 立即切换)
+ */
+void LampController::setEffect(EffectMode mode, uint32_t fade_ms) {
+    post(make_command(LampCommand::Type::Effect, (uint16_t)mode, fade_ms));
+}
+
+/**
+ * @brief 特效名 -> EffectMode
+ *
+ * @return false 表示未知名称 (out 不变)
+ */
+bool LampController::effectFromName(const char* name, EffectMode &out) {
+    const uint8_t id = kEffectNames.find(name);
+    if (id == kEffectNames.kNotFound) return false;
+    out = (EffectMode)id;
+    return true;
+}
+
+/**
+ * @brief 严格解析文本指令中的十进制整数
+ *
+ * 只接受数字字符 (不接受符号、空白、小数与单位后缀)，整个字符串须被消耗。
+ *
+ * @return false 表示为空、含非数字字符或不在 [minValue, maxValue] 内 (out 不变)
+ */
+bool LampController::parseUint(const char* text, uint32_t minValue, uint32_t maxValue, uint32_t &out) {
+    if (text == nullptr || *text < '0' || *text > '9') return false;
+    char* end = nullptr;
+    const unsigned long v = strtoul(text, &end, 10);
+    if (*end != '\0' || v < minValue || v > maxValue) return false;
+    out = (uint32_t)v;
+    return true;
+}
+
+/**
+ * @brief 严格解析 "r:g:b" (各分量 0-255 的十进制整数)
+ *
+ * @return false 表示格式错误 (r/g/b 不变)
+ */
+bool LampController::parseRgb(const char* text, uint8_t &r, uint8_t &g, uint8_t &b) {
+    if (text == nullptr) return false;
+    char buf[12];
+    const size_t len = strlen(text);
+    if (len >= sizeof(buf)) return false;
+    memcpy(buf, text, len + 1);
+
+    uint32_t c[3];
+    char* part = buf;
+    for (uint8_t i = 0; i < 3; i++) {
+        char* sep = strchr(part, ':');
+        if ((sep == nullptr) != (i == 2)) return false;
+        if (sep) *sep = '\0';
+        if (!parseUint(part, 0, 255, c[i])) return false;
+        if (sep) part = sep + 1;
+    }
+    r = (uint8_t)c[0];
+    g = (uint8_t)c[1];
+    b = (uint8_t)c[2];
+    return true;
+}
+
+/**
+ * @brief 解析文本指令中的渐变时长
+ *
+ * @return false 表示为空、含非数字字符 (含负号) 或超过 MAX_FADE_MS (out 不变)
+ */
+bool LampController::parseFadeMs(const char* text, uint32_t &out) {
+    return parseUint(text, 0, MAX_FADE_MS, out);
+}
+
+/**
+ * @brief 设置特效模式 (字符串)，未知名称视为 None
+ */
+void LampController::setEffect(const char* effectName, uint32_t fade_ms) {
+    EffectMode mode = EffectMode::None;
+    effectFromName(effectName, mode);
+    setEffect(mode, fade_ms);
+}
+
+/**
+ * @brief 设置特效参数
+ *
+ * @param fields EffectParamField 掩码，只有被选中的字段会覆盖当前值
+ */
+void LampController::setEffectParams(EffectMode mode, const EffectParams &params, uint8_t fields) {
+    LampCommand cmd = make_command(LampCommand::Type::EffectParams);
+    cmd.r = (uint8_t)mode;
+    cmd.g = fields;
+    cmd.params = params;
+    post(cmd);
+}
+
+/**
+ * @brief 设置当前特效的参数 (在 LampTask 中解析“当前特效”)
+ */
+void LampController::setEffectParams(const EffectParams &params, uint8_t fields) {
+    LampCommand cmd = make_command(LampCommand::Type::EffectParams);
+    cmd.r = 0xFF;
+    cmd.g = fields;
+    cmd.params = params;
+    post(cmd);
+}
+
+/**
+ * @brief 设置特效参数 (文本形式，供 MQTT / BLE 共用)
+ *
+ * "speed=200,intensity=90" 作用于当前特效；首项为特效名时作用于该特效，
+ * 如 "meteor,pal=ocean,dir=rev"。只修改出现的字段；speed/intensity 为 0-255，dir 为 fwd/rev/0/1。
+ *
+ * @return false 表示格式错误或名称未知 (不下发任何修改)
+ */
+bool LampController::setEffectParams(const char* spec) {
+    if (spec == nullptr) return false;
+    char buf[96];
+    strncpy(buf, spec, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    EffectParams p{};
+    uint8_t fields = 0;
+    bool hasMode = false;
+    EffectMode mode = EffectMode::None;
+
+    char* save = nullptr;
+    for (char* tok = strtok_r(buf, ",", &save); tok; tok = strtok_r(nullptr, ",", &save)) {
+        char* eq = strchr(tok, '=');
+        if (eq == nullptr) {
+            // 不带 '=' 的只能是第一项 (特效名)
+            if (fields != 0 || hasMode || !effectFromName(tok, mode)) return false;
+            hasMode = true;
+            continue;
+        }
+        *eq = '\0';
+        const char* key = tok;
+        const char* val = eq + 1;
+        uint32_t num = 0;
+
+        if (strcmp(key, "speed") == 0) {
+            if (!parseUint(val, 0, 255, num)) return false;
+            p.speed = (uint8_t)num;
+            fields |= EFP_SPEED;
+        } else if (strcmp(key, "intensity") == 0) {
+            if (!parseUint(val, 0, 255, num)) return false;
+            p.intensity = (uint8_t)num;
+            fields |= EFP_INTENSITY;
+        } else if (strcmp(key, "pal") == 0 || strcmp(key, "palette") == 0) {
+            if (!palette_from_name(val, p.palette)) return false;
+            fields |= EFP_PALETTE;
+        } else if (strcmp(key, "dir") == 0) {
+            if (strcmp(val, "rev") == 0 || strcmp(val, "1") == 0) p.reverse = 1;
+            else if (strcmp(val, "fwd") == 0 || strcmp(val, "0") == 0) p.reverse = 0;
+            else return false;
+            fields |= EFP_REVERSE;
+        } else {
+            return false;
+        }
+    }
+    if (fields == 0) return false;
+
+    if (hasMode) setEffectParams(mode, p, fields);
+    else setEffectParams(p, fields);
+    return true;
+}
+
+/**
+ * @brief 设置指定特效使用的调色板
+ */
+void LampController::setEffectPalette(EffectMode mode, PaletteId palette) {
+    EffectParams p{};
+    p.palette = palette;
+    setEffectParams(mode, p, EFP_PALETTE);
+}
+
+/**
+ * @brief 设置当前特效使用的调色板
+ */
+void LampController::setEffectPalette(PaletteId palette) {
+    EffectParams p{};
+    p.palette = palette;
+    setEffectParams(p, EFP_PALETTE);
+}
+
+/**
+ * @brief 设置叠加层
+ *
+ * @param layer 1 .. MAX_LAYERS-1 (越大越靠上)
+ * @param mode  该层特效，None 移除该层
+ * @param blend 与下方合成结果的混合方式
+ * @param alpha 该层不透明度 0-255
+ */
+void LampController::setOverlay(uint8_t layer, EffectMode mode, BlendMode blend, uint8_t alpha) {
+    LampCommand cmd = make_command(LampCommand::Type::Overlay, (uint16_t)mode);
+    cmd.r = layer;
+    cmd.g = (uint8_t)blend;
+    cmd.b = alpha;
+    post(cmd);
+}
+
+/**
+ * @brief 设置场景模式
+ *
+ * @return false 表示名称为空指针或超过 11 字符 (不下发任何修改)
+ */
+bool LampController::setScene(const char* scene, uint8_t excludeMask) {
+    LampCommand cmd = make_command(LampCommand::Type::Scene, 0, 0, excludeMask);
+    if (!copy_scene_name(cmd, scene)) return false;
+    post(cmd);
+    return true;
+}
+
+/**
+ * @brief 保存用户场景 (文本形式，供 MQTT / BLE 共用)
+ *
+ * 未给出的字段取当前快照中的灯光状态，因此只给名称即保存当前状态。
+ *
+ * @return false 表示格式错误或名称过长
+ */
+bool LampController::saveScene(const char* spec) {
+    LampStateSnapshot st;
+    getState(st);
+
+    LampCommand cmd = make_command(LampCommand::Type::SceneStore);
+    SceneDef &def = cmd.sceneDef;
+    def.brightness = st.savedBrightness;
+    def.cctMode = st.cctMode ? 1 : 0;
+    def.cct = st.cct;
+    def.r = st.rgb.r;
+    def.g = st.rgb.g;
+    def.b = st.rgb.b;
+    def.fadeMs = 500;
+    if (!scene_parse(spec, def)) return false;
+
+    post(cmd);
+    return true;
+}
+
+/**
+ * @brief 删除用户场景 (内置场景不可删除)
+ *
+ * @return false 表示名称为空指针或超过 11 字符 (不会误删同前缀的场景)
+ */
+bool LampController::deleteScene(const char* name) {
+    LampCommand cmd = make_command(LampCommand::Type::SceneDelete);
+    if (!copy_scene_name(cmd, name)) return false;
+    post(cmd);
+    return true;
+}
+
+/**
+ * @brief 设置分区状态
+ *
+ * @param zone   分区序号，从 0 开始
+ * @param fields ZoneField 掩码，只有被选中的字段会覆盖当前值
+ */
+void LampController::setZone(uint8_t zone, const ZoneParams &params, uint8_t fields, uint32_t fade_ms,
+                             uint8_t excludeMask) {
+    LampCommand cmd = make_command(LampCommand::Type::Zone, 0, fade_ms, excludeMask);
+    cmd.r = zone;
+    cmd.g = fields;
+    cmd.zone = params;
+    post(cmd);
+}
+
+/**
+ * @brief 设置分区状态 (文本形式，供 MQTT / BLE 共用)
+ *
+ * 首项为分区号 (从 1 开始)，其后为 "on=0|1" / "bri=40" / "cct=3000" / "rgb=255:0:0" / "fade=800"，
+ * 或单词 on / off / follow (取消颜色覆盖)。如 "2,bri=40,cct=3000"、"3,off"、"1,follow"。
+ *
+ * @return false 表示格式错误 (不下发任何修改)
+ */
+bool LampController::setZone(const char* spec, uint8_t excludeMask) {
+    if (spec == nullptr) return false;
+    char buf[96];
+    strncpy(buf, spec, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    char* save = nullptr;
+    char* tok = strtok_r(buf, ",", &save);
+    if (tok == nullptr) return false;
+    uint32_t number = 0;
+    if (!parseUint(tok, 1, NUM_ZONES, number)) return false;
+
+    ZoneParams p{};
+    uint8_t fields = 0;
+    uint32_t fade = 500;
+
+    while ((tok = strtok_r(nullptr, ",", &save)) != nullptr) {
+        char* eq = strchr(tok, '=');
+        if (eq == nullptr) {
+            if (strcmp(tok, "on") == 0 || strcmp(tok, "off") == 0) {
+                p.on = tok[1] == 'n';
+                fields |= ZF_ON;
+            } else if (strcmp(tok, "follow") == 0) {
+                fields |= ZF_FOLLOW;
+            } else {
+                return false;
+            }
+            continue;
+        }
+        *eq = '\0';
+        const char* key = tok;
+        const char* val = eq + 1;
+        uint32_t num = 0;
+
+        if (strcmp(key, "on") == 0) {
+            if (!parseUint(val, 0, 1, num)) return false;
+            p.on = num != 0;
+            fields |= ZF_ON;
+        } else if (strcmp(key, "bri") == 0) {
+            if (!parseUint(val, 1, 100, num)) return false;
+            p.level = (uint8_t)num;
+            fields |= ZF_LEVEL;
+        } else if (strcmp(key, "cct") == 0) {
+            if (!parseUint(val, 1000, 20000, num)) return false;
+            p.cct = (uint16_t)num;
+            fields = (fields & ~ZF_RGB) | ZF_CCT;
+        } else if (strcmp(key, "rgb") == 0) {
+            if (!parseRgb(val, p.r, p.g, p.b)) return false;
+            fields = (fields & ~ZF_CCT) | ZF_RGB;
+        } else if (strcmp(key, "fade") == 0) {
+            if (!parseFadeMs(val, fade)) return false;
+        } else {
+            return false;
+        }
+    }
+    if (fields == 0) return false;
+
+    setZone((uint8_t)(number - 1), p, fields, fade, excludeMask);
+    return true;
+}
+
+void LampController::setAutoBrightness(bool enable) {
+    post(make_command(LampCommand::Type::AutoBrightness, enable ? 1 : 0));
+}
+
+void LampController::setReducedFrameRate(bool enable) {
+    post(make_command(LampCommand::Type::ReducedFrameRate, enable ? 1 : 0));
+}
@@ -10,23 +10,28 @@ LampController lamp;
 // =================================================================================
 
 void LampController::init() {
-    FastLED.addLeds<LAMP_LED_TYPE, LAMP_DATA_PIN, LAMP_COLOR_ORDER>(m_leds, LAMP_NUM_LEDS);
+    FastLED.addLeds<LAMP_LED_TYPE, LAMP_DATA_PIN, LAMP_COLOR_ORDER>(m_frontLeds, LAMP_NUM_LEDS);
     FastLED.clear(true);
 
     m_mutex = xSemaphoreCreateMutex();
+    m_uploadMutex = xSemaphoreCreateMutex();
+    m_cmdQueue = xQueueCreate(CMD_QUEUE_LEN, sizeof(LampCommand));
 
     loadStateFromNVS();
     m_dirty_on = m_dirty_br = m_dirty_cct = false;
     m_lastChangeMs = 0;
 
-    m_brightness = 0;
+    setBrightnessQ16(0);
     update();
+    flushFrame();
 
     if (m_on) {
         uint8_t saved = (m_savedOnBrightness > 0 ? m_savedOnBrightness : 50);
         uint8_t target = map(saved, 1, 100, kMinVisibleBrightness, 100);
-        fadeToBrightness(target, 1000);
+        fadeToBrightness(target, 1000, true);
     }
+    publishState();
+
     // Notify UI of current lamp state so UI can initialize correctly
     UIEvent evt_br{UI_EVENT_BRIGHTNESS, (int)getSavedBrightness(), 0.0f};
     send_ui_event(evt_br);
@@ -54,86 +59,131 @@ void LampController::taskEntry(void *pvParameters) {
     if (self) self->taskLoop(); else vTaskDelete(nullptr);
 }
 
-void LampController::taskLoop() {
-    TickType_t last = xTaskGetTickCount();
-    uint32_t elapsed = 0;
-    uint32_t elapsedColor = 0;
-    uint8_t start = m_brightness;
+/**
+ * @brief 唤醒 LampTask
+ *
+ * 空闲时 LampTask 阻塞在任务通知上；post() 投递命令后调用此函数，
+ * 使任务在下一帧开头取出并应用命令。
+ */
+void LampController::wake() {
+    if (m_taskHandle) xTaskNotifyGive(m_taskHandle);
+}
 
-    uint8_t lastTarget = m_targetBrightness;
-    uint16_t lastTargetCCT = m_targetCCT;
-    CRGB lastTargetRGB = m_targetRGB;
-    bool lastUseCCT = m_useCCT;
+/**
+ * @brief 是否需要按 m_frameMs 帧时钟运行
+ */
+bool LampController::isAnimating() const {
+    if (m_tween.anyActive() && !m_tweenSleep) return true;
+    if (m_streamActive) return false; // 流帧由接收任务 wake() 驱动，不占用帧时钟
+    return isCompositing() && (m_on || m_brightness > 0);
+}
 
-    for (;;) {
-        if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
-            // 1) 亮度渐变
-            if (m_fadeActive && m_targetBrightness != lastTarget) {
-                start = m_brightness;
-                elapsed = 0;
-                lastTarget = m_targetBrightness;
-            }
+/**
+ * @brief 空闲时的最长阻塞时间
+ *
+ * 有延迟提交、实时流或慢速渐变时，等待到提交时刻/流超时时刻/渐变输出下一次变化；
+ * 否则无限期等待通知。
+ */
+TickType_t LampController::idleWaitTicks() const {
+    TickType_t wait = portMAX_DELAY;
+    const uint32_t now = millis();
+    if (hasPendingFlush()) {
+        uint32_t since = now - m_lastChangeMs;
+        wait = since >= COMMIT_DELAY_MS ? 0 : pdMS_TO_TICKS(COMMIT_DELAY_MS - since);
+    }
+    if (m_streamActive) {
+        uint32_t since = now - m_streamLastMs;
+        TickType_t streamWait = since >= STREAM_TIMEOUT_MS ? 0 : pdMS_TO_TICKS(STREAM_TIMEOUT_MS - since) + 1;
+        if (streamWait < wait) wait = streamWait;
+    }
+    if (m_tweenSleep) {
+        TickType_t tweenWait = pdMS_TO_TICKS(m_tweenWaitMs) + 1;
+        if (tweenWait < wait) wait = tweenWait;
+    }
+    return wait;
+}
 
-            if (m_fadeActive) {
-                (void)advanceFade(elapsed, start);
-            } else {
-                start = m_brightness;
-                elapsed = 0;
-                lastTarget = m_targetBrightness;
-            }
+void LampController::taskLoop() {
+    TickType_t last = xTaskGetTickCount();
+    uint32_t lastFrameUs = micros() - (uint32_t)m_frameMs * 1000;
+    uint32_t tweenSleptUs = 0; // 慢速渐变休眠期间流逝、尚未推进的时间
 
-            // 2) 颜色渐变
-            bool colorChanged = false;
-            if (m_useCCT != lastUseCCT) {
-                colorChanged = true;
-            } else if (m_useCCT) {
-                if (m_targetCCT != lastTargetCCT) colorChanged = true;
-            } else {
-                if (m_targetRGB.r != lastTargetRGB.r ||
-                    m_targetRGB.g != lastTargetRGB.g ||
-                    m_targetRGB.b != lastTargetRGB.b) {
-                    colorChanged = true;
-                }
-            }
+    for (;;) {
+        bool animating = false;
+        bool tweenSleep = false;
+        TickType_t idleWait = portMAX_DELAY;
 
-            if (m_colorFadeActive && colorChanged) {
-                elapsedColor = 0;
-                lastUseCCT = m_useCCT;
-                lastTargetCCT = m_targetCCT;
-                lastTargetRGB = m_targetRGB;
+        if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
+            const uint32_t lockStart = micros();
+
+            // 帧时间：按实际流逝时间推进渐变与特效，与帧率和调度抖动无关
+            uint32_t dt_us = lockStart - lastFrameUs;
+            if (dt_us > MAX_FRAME_US) dt_us = MAX_FRAME_US;
+            lastFrameUs = lockStart;
+
+            // 0) 应用其他任务投递的控制命令；慢速渐变休眠的时间先补给已有轨道，
+            //    命令新启动的渐变从本帧开始计时
+            if (tweenSleptUs) {
+                advanceTweens(tweenSleptUs);
+                tweenSleptUs = 0;
             }
+            drainCommands();
 
-            if (m_colorFadeActive) {
-                (void)advanceColorFade(elapsedColor);
-            } else {
-                elapsedColor = 0;
-                lastUseCCT = m_useCCT;
-                lastTargetCCT = m_targetCCT;
-                lastTargetRGB = m_targetRGB;
-            }
+            // 1) 渐变 (亮度/色温/RGB 各自独立推进)
+            advanceTweens(dt_us);
 
-            // 3) 延迟存储
+            // 2) 延迟存储
             flushIfIdle();
             
-            // 4) 特效
-            if (m_effect != EffectMode::None) {
+            // 3) 特效 (图层合成)；实时流优先，超时后本帧即回到特效
+            if (!serviceStream() && isCompositing()) {
                 if (m_on || m_brightness > 0) {
-                    runEffect();
+                    runEffect(dt_us);
                 } else {
-                    FastLED.clear();
-                    FastLED.show();
+                    fill_solid(m_leds, LAMP_NUM_LEDS, CRGB::Black);
+                    presentFrame();
                 }
             }
+
+            // 4) 发布状态快照 (仅在变化时)
+            publishState();
+
+            scheduleTweens();
+            animating = isAnimating();
+            if (!animating) idleWait = idleWaitTicks();
+            tweenSleep = !animating && m_tweenSleep;
             
+            recordLockHold(micros() - lockStart);
             xSemaphoreGive(m_mutex);
         }
 
-        vTaskDelayUntil(&last, pdMS_TO_TICKS(STEP_MS));
+        // 5) 锁外输出：合成已在锁内完成，show() 的线上传输不再占用 m_mutex
+        flushFrame();
+
+        if (animating) {
+            vTaskDelayUntil(&last, pdMS_TO_TICKS(m_frameMs));
+        } else {
+            // 空闲：阻塞直到被 wake() 通知或延迟提交到期
+            ulTaskNotifyTake(pdTRUE, idleWait);
+            last = xTaskGetTickCount(); // 避免 vTaskDelayUntil 补跑空闲期间的帧
+            if (tweenSleep) {
+                // 慢速渐变按实际流逝时间推进 (不受 MAX_FRAME_US 限制)
+                const uint32_t now = micros();
+                tweenSleptUs = now - lastFrameUs;
+                lastFrameUs = now;
+            } else {
+                // 唤醒后的第一帧按一个标准帧间隔推进，而不是整段空闲时间
+                lastFrameUs = micros() - (uint32_t)m_frameMs * 1000;
+            }
+        }
     }
 }
 
 // =================================================================================
-// 2. 核心控制接口
+// 2. 核心控制（LampTask 内执行）
+//
+// 以下 apply* 由 drainCommands() 在 LampTask 持有 m_mutex 时调用；
+// 其他任务通过 lamp_command.cpp 中的 set* 接口投递命令，不直接进入这里。
 // =================================================================================
 
 /**
@@ -142,42 +192,32 @@ void LampController::taskLoop() {
  * @param on true=开灯, false=关灯
  * @param fade_ms 渐变时间(ms)
  */
-void LampController::setPower(bool on, uint16_t fade_ms, uint8_t excludeMask) {
-    if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
-        cancelFade();
+void LampController::applyPower(bool on, uint32_t fade_ms, uint8_t excludeMask) {
+    cancelFade();
+    
+    if (on) {
+        m_on = true;
+        uint8_t saved = getSavedBrightness();
+        uint8_t target = map(saved, 1, 100, kMinVisibleBrightness, 100);
+        fadeToBrightness(target, fade_ms, true);
+        UIEvent evt{UI_EVENT_LIGHT, 1};
+        send_ui_event(evt, excludeMask);
+    } else {
+        m_on = false;
         
-        if (on) {
-            m_on = true;
-            uint8_t saved = getSavedBrightness();
-            uint8_t target = map(saved, 1, 100, kMinVisibleBrightness, 100);
-            fadeToBrightness(target, fade_ms);
-            UIEvent evt{UI_EVENT_LIGHT, 1};
-            send_ui_event(evt, excludeMask);
+        // 特殊处理：如果正在运行特效，用户希望“直接关闭”而不是等待渐变或特效周期
+        if (isCompositing()) {
+            fadeToBrightness(0, 0, true); // 立即关闭
         } else {
-            m_on = false;
-            
-            // 特殊处理：如果正在运行特效，用户希望“直接关闭”而不是等待渐变或特效周期
-            if (m_effect != EffectMode::None) {
-                fadeToBrightness(0, 0); // 立即关闭
-            } else {
-                fadeToBrightness(0, fade_ms);
-            }
-            
-            UIEvent evt{UI_EVENT_LIGHT, 0};
-            send_ui_event(evt, excludeMask);
+            fadeToBrightness(0, fade_ms, true);
         }
         
-        m_dirty_on = true; 
-        markChanged();
-        xSemaphoreGive(m_mutex);
+        UIEvent evt{UI_EVENT_LIGHT, 0};
+        send_ui_event(evt, excludeMask);
     }
-}
-
-/**
- * @brief 切换电源状态
- */
-void LampController::togglePower(uint16_t fade_ms) {
-    setPower(!m_on, fade_ms);
+    
+    m_dirty_on = true; 
+    markChanged();
 }
 
 /**
@@ -191,9 +231,9 @@ bool LampController::isOn() const {
  * @brief 设置亮度
  * 
  * @param percent 用户输入的亮度 0-100
- * @param fade_ms 渐变时间 (0 表示立即设置)
+ * @param fade_ms 渐变时间 (0 表示立即设置)，不随亮度差缩放
  */
-void LampController::setBrightness(uint8_t percent, uint16_t fade_ms, uint8_t excludeMask) {
+void LampController::applyBrightness(uint8_t percent, uint32_t fade_ms, uint8_t excludeMask) {
     if (percent > 100) percent = 100;
     
     // 修正：用户设置亮度最小为 1%，0% 仅由关灯触发
@@ -204,25 +244,23 @@ void LampController::setBrightness(uint8_t percent, uint16_t fade_ms, uint8_t ex
         internal_val = map(percent, 1, 100, kMinVisibleBrightness, 100);
     }
 
-    if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
-        if (m_on) {
-            if (fade_ms > 0) {
-                fadeToBrightness(internal_val, fade_ms);
-            } else {
-                cancelFade();
-                m_brightness = internal_val;
-                update();
-            }
-            
-            if (percent > 0) {
-                m_savedOnBrightness = percent;
-                m_dirty_br = true;
-            }
-
-            UIEvent evt{UI_EVENT_BRIGHTNESS, percent};
-            send_ui_event(evt, excludeMask);
+    if (m_on) {
+        if (fade_ms > 0) {
+            fadeToBrightness(internal_val, fade_ms, false); // 指定时长原样执行
+        } else {
+            cancelFade();
+            setBrightnessQ16((uint32_t)internal_val << 16);
+            update();
+        }
+        
+        if (percent > 0) {
+            m_savedOnBrightness = percent;
+            m_dirty_br = true;
+            markChanged();
         }
-        xSemaphoreGive(m_mutex);
+
+        UIEvent evt{UI_EVENT_BRIGHTNESS, percent};
+        send_ui_event(evt, excludeMask);
     }
 }
 
@@ -236,42 +274,64 @@ uint8_t LampController::getBrightness() const {
 /**
  * @brief 设置色温 (切换到 CCT 模式)
  */
-void LampController::setCCT(uint16_t cct, uint16_t fade_ms, uint8_t excludeMask) {
-    if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
-        if (cct < LAMP_CCT_MIN) cct = LAMP_CCT_MIN;
-        if (cct > LAMP_CCT_MAX) cct = LAMP_CCT_MAX;
+void LampController::applyCCT(uint16_t cct, uint32_t fade_ms, uint8_t excludeMask) {
+    if (cct < LAMP_CCT_MIN) cct = LAMP_CCT_MIN;
+    if (cct > LAMP_CCT_MAX) cct = LAMP_CCT_MAX;
 
-        if (m_useCCT && fade_ms > 0) {
-            m_startCCT = m_cct;
-            m_targetCCT = cct;
-            m_colorFadeDurationMs = fade_ms;
-            m_colorFadeActive = true;
-            m_fadingToCCT = false;
-        } else if (!m_useCCT && fade_ms > 0) {
-            m_startRGB = m_rgbColor;
-            uint8_t r, g, b;
-            cctToRawRGB(cct, r, g, b);
-            m_targetRGB = CRGB(r, g, b);
-            m_targetCCT = cct;
-            m_useCCT = false;
-            m_colorFadeDurationMs = fade_ms;
-            m_colorFadeActive = true;
-            m_fadingToCCT = true;
-        } else {
-            m_cct = cct;
-            m_useCCT = true;
-            m_colorFadeActive = false;
-            m_fadingToCCT = false;
-            update();
-        }
-        
-        UIEvent evt{UI_EVENT_CCT, cct};
-        send_ui_event(evt, excludeMask);
+    startCCTFade(cct, fade_ms);
+    if (fade_ms == 0) update();
+    
+    UIEvent evt{UI_EVENT_CCT, cct};
+    send_ui_event(evt, excludeMask);
 
-        m_dirty_cct = true;
-        m_dirty_mode = true;
-        markChanged();
-        xSemaphoreGive(m_mutex);
+    m_dirty_cct = true;
+    m_dirty_mode = true;
+    markChanged();
+}
+
+/**
+ * @brief 启动 (或立即切换到) 色温 cct，不发送事件、不标记持久化
+ */
+void LampController::startCCTFade(uint16_t cct, uint32_t fade_ms) {
+    if (m_useCCT && fade_ms > 0) {
+        m_tween.start(TWEEN_CCT, m_cct, cct, fade_ms, m_curve);
+        m_fadingToCCT = false;
+    } else if (!m_useCCT && fade_ms > 0) {
+        // RGB 模式下先渐变到目标色温对应的 RGB，结束后切回 CCT 模式
+        uint8_t r, g, b;
+        cctToRawRGB(cct, r, g, b);
+        startRGBTween(CRGB(r, g, b), fade_ms);
+        m_targetCCT = cct;
+        m_fadingToCCT = true;
+    } else {
+        m_cct = cct;
+        m_useCCT = true;
+        cancelColorTweens();
+        m_fadingToCCT = false;
+    }
+}
+
+/**
+ * @brief 启动 (或立即切换到) RGB 颜色 target，不发送事件、不标记持久化
+ */
+void LampController::startColorFade(const CRGB &target, uint32_t fade_ms) {
+    if (!m_useCCT && fade_ms > 0) {
+        startRGBTween(target, fade_ms);
+        m_fadingToCCT = false;
+    } else if (m_useCCT && fade_ms > 0) {
+        // 从当前色温对应的 RGB 起步
+        uint8_t r0, g0, b0;
+        cctToRawRGB(m_cct, r0, g0, b0);
+        m_rgbColor = CRGB(r0, g0, b0);
+        m_tween.cancel(TWEEN_CCT);
+        m_useCCT = false;
+        startRGBTween(target, fade_ms);
+        m_fadingToCCT = false;
+    } else {
+        m_rgbColor = target;
+        m_useCCT = false;
+        cancelColorTweens();
+        m_fadingToCCT = false;
     }
 }
 
@@ -279,65 +339,34 @@ void LampController::setCCT(uint16_t cct, uint16_t fade_ms, uint8_t excludeMask)
  * @brief 获取当前色温
  */
 uint16_t LampController::getCCT() const { 
-    if (m_colorFadeActive && m_useCCT) return m_targetCCT;
+    int32_t target;
+    if (m_useCCT && m_tween.target(TWEEN_CCT, target)) return (uint16_t)target;
     return m_cct; 
 }
 
 /**
  * @brief 设置 RGB 颜色 (切换到 RGB 模式)
  */
-void LampController::setColor(uint8_t r, uint8_t g, uint8_t b, uint16_t fade_ms, uint8_t excludeMask) {
-    if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
-        CRGB target(r, g, b);
-        
-        if (!m_useCCT && fade_ms > 0) {
-            m_startRGB = m_rgbColor;
-            m_targetRGB = target;
-            m_colorFadeDurationMs = fade_ms;
-            m_colorFadeActive = true;
-            m_fadingToCCT = false;
-        } else if (m_useCCT && fade_ms > 0) {
-            uint8_t r0, g0, b0;
-            cctToRawRGB(m_cct, r0, g0, b0);
-            m_startRGB = CRGB(r0, g0, b0);
-            m_targetRGB = target;
-            m_useCCT = false;
-            m_colorFadeDurationMs = fade_ms;
-            m_colorFadeActive = true;
-            m_fadingToCCT = false;
-        } else {
-            m_rgbColor = target;
-            m_useCCT = false;
-            m_colorFadeActive = false;
-            m_fadingToCCT = false;
-            update();
-        }
+void LampController::applyColor(uint8_t r, uint8_t g, uint8_t b, uint32_t fade_ms, uint8_t excludeMask) {
+    startColorFade(CRGB(r, g, b), fade_ms);
+    if (fade_ms == 0) update();
 
-        int rgbValue = (r << 16) | (g << 8) | b;
-        UIEvent evt{UI_EVENT_RGB, rgbValue};
-        send_ui_event(evt, excludeMask);
+    int rgbValue = (r << 16) | (g << 8) | b;
+    UIEvent evt{UI_EVENT_RGB, rgbValue};
+    send_ui_event(evt, excludeMask);
 
-        m_dirty_rgb = true;
-        m_dirty_mode = true;
-        markChanged();
-        xSemaphoreGive(m_mutex);
-    }
-}
-
-/**
- * @brief 设置 HSV 颜色 (切换到 RGB 模式)
- */
-void LampController::setHSV(uint8_t h, uint8_t s, uint8_t v, uint16_t fade_ms, uint8_t excludeMask) {
-    CRGB rgb;
-    rgb.setHSV(h, s, v);
-    setColor(rgb.r, rgb.g, rgb.b, fade_ms, excludeMask);
+    m_dirty_rgb = true;
+    m_dirty_mode = true;
+    markChanged();
 }
 
 /**
  * @brief 获取当前 RGB 颜色
  */
 CRGB LampController::getRGB() const {
-    if (m_colorFadeActive && !m_useCCT) return m_targetRGB;
+    if (m_useCCT) return m_rgbColor;
+
+    if (m_tween.isActive(TWEEN_COLOR)) return m_colorFade.target();
     return m_rgbColor;
 }
 
@@ -351,15 +380,12 @@ bool LampController::isCCTMode() const {
 /**
  * @brief 设置开灯记忆亮度
  */
-void LampController::setSavedBrightness(uint8_t percent) {
+void LampController::applySavedBrightness(uint8_t percent) {
     if (percent > 100) percent = 100;
     if (percent > 0) {
-        if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
-            m_savedOnBrightness = percent;
-            m_dirty_br = true; 
-            markChanged();
-            xSemaphoreGive(m_mutex);
-        }
+        m_savedOnBrightness = percent;
+        m_dirty_br = true; 
+        markChanged();
     }
 }
 
@@ -377,94 +403,199 @@ uint8_t LampController::getSavedBrightness() const {
 /**
  * @brief 设置特效模式
  */
-void LampController::setEffect(EffectMode mode) {
-    if (xSemaphoreTake(m_mutex, portMAX_DELAY)) {
-        m_effect = mode;
-        m_effectTick = 0;
-        if (mode != EffectMode::None) {
-            m_scene = "None"; // 启用特效时清除场景
-        }
-        if (mode == EffectMode::None) {
-            update();
-        }
-        xSemaphoreGive(m_mutex);
+void LampController::applyEffect(EffectMode mode, uint32_t fade_ms) {
+    // 灯亮且确实换了特效时交叉淡化：旧底层带着自己的时间轴继续播放并逐渐淡出。
+    // 淡化途中再次切换时，以当前底层作为新的淡出层。
+    if (fade_ms > 0 && mode != m_effect && m_on && m_brightness > 0) {
+        m_xfadeFrom.mode = m_effect;
+        m_xfadeFrom.ms = m_effectMs;
+        m_xfadeFrom.usRem = m_effectUsRem;
+        m_xfadeAlpha = 0;
+        m_tween.start(TWEEN_CROSSFADE, 0, 255, fade_ms, FadeCurve::Linear);
+    } else {
+        m_tween.cancel(TWEEN_CROSSFADE);
+        m_xfadeAlpha = 255;
+    }
+
+    m_effect = mode;
+    m_effectMs = 0;
+    m_effectUsRem = 0;
+    if (mode == EffectMode::Animation) beginAnimation();
+    if (mode != EffectMode::None) {
+        m_scene = kSceneNone; // 启用特效时清除场景
     }
+    if (!isCompositing()) {
+        update();
+    }
+
+    // 只通知本地界面刷新特效参数控件 (快照先发布，界面从快照读取)
+    publishState();
+    UIEvent evt{UI_EVENT_EFFECT, (int)mode};
+    send_ui_event(evt, (uint8_t)DEST_MQTT | DEST_BLE);
 }
 
 /**
- * @brief 获取当前特效模式
+ * @brief 更新特效参数 (越界时忽略)，随延迟提交写入 NVS
  */
-EffectMode LampController::getEffect() const {
-    return m_effect;
+void LampController::applyEffectParams(EffectMode mode, const EffectParams &params, uint8_t fields) {
+    if ((uint8_t)mode >= EFFECT_MODE_COUNT) return;
+
+    EffectParams &p = m_effectParams[(uint8_t)mode];
+    if (fields & EFP_SPEED) p.speed = params.speed;
+    if (fields & EFP_INTENSITY) p.intensity = params.intensity;
+    if ((fields & EFP_PALETTE) && params.palette < PaletteId::Count) p.palette = params.palette;
+    if (fields & EFP_REVERSE) p.reverse = params.reverse ? 1 : 0;
+
+    m_dirty_fx = true;
+    markChanged();
+
+    if (mode == m_effect) {
+        publishState();
+        UIEvent evt{UI_EVENT_EFFECT, (int)mode};
+        send_ui_event(evt, (uint8_t)DEST_MQTT | DEST_BLE);
+    }
 }
 
 /**
- * @brief 设置特效模式 (字符串)
+ * @brief 设置白点校准矩阵，色温缓存失效并立即刷新输出
  */
-void LampController::setEffect(const char* effectName) {
-    String s = String(effectName);
-    s.toLowerCase();
-    
-    EffectMode mode = EffectMode::None;
-    if (s == "rainbow") mode = EffectMode::Rainbow;
-    else if (s == "breathing") mode = EffectMode::Breathing;
-    else if (s == "police") mode = EffectMode::Police;
-    else if (s == "spin") mode = EffectMode::Spin;
-    else if (s == "meteor") mode = EffectMode::Meteor;
-    else if (s == "none") mode = EffectMode::None;
-    
-    setEffect(mode);
+void LampController::applyCctCalibration(const CctCalibration &cal) {
+    for (uint8_t i = 0; i < 9; i++) {
+        int16_t v = cal.m[i];
+        if (v > CctCalibration::kLimit) v = CctCalibration::kLimit;
+        if (v < -CctCalibration::kLimit) v = -CctCalibration::kLimit;
+        m_cctCal.m[i] = v;
+    }
+    m_cctRgbK = 0;
+
+    // 以色温覆盖的分区按新矩阵重算
+    for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+        Zone &z = m_zones[i];
+        if (z.follow || z.releasing || !z.cctMode) continue;
+        startZoneColor(i, z.color, cct_to_rgb(z.cct, m_cctCal), 0);
+    }
+    update();
+
+    m_dirty_cal = true;
+    markChanged();
 }
 
 /**
- * @brief 设置场景模式
- * 
- * 封装了常用的场景预设，如阅读、夜灯等。
+ * @brief 设置叠加层 (序号越界时忽略)
  */
-void LampController::setScene(const char* scene, uint8_t excludeMask) {
-    String s = String(scene);
-    s.toLowerCase();
-    
-    // 场景模式 (宏)
-    if (s == "reading") {
-        setCCT(4500, 500, excludeMask);
-        setBrightness(80, 500, excludeMask);
-        m_scene = "Reading";
+void LampController::applyOverlay(uint8_t layer, EffectMode mode, BlendMode blend, uint8_t alpha) {
+    if (layer == 0 || layer >= MAX_LAYERS) return;
+
+    EffectLayer &l = m_overlays[layer - 1];
+    if (l.mode != mode) {
+        l.ms = 0;
+        l.usRem = 0;
     }
-    else if (s == "night") {
-        setCCT(2700, 500, excludeMask);
-        setBrightness(5, 500, excludeMask);
-        m_scene = "Night";
+    l.mode = mode;
+    l.blend = blend;
+    l.alpha = alpha;
+
+    if (!isCompositing()) {
+        update();
     }
-    else if (s == "cozy") {
-        setCCT(3000, 500, excludeMask);
-        setBrightness(50, 500, excludeMask);
-        m_scene = "Cozy";
+}
+
+/**
+ * @brief 获取当前特效模式
+ */
+EffectMode LampController::getEffect() const {
+    return m_effect;
+}
+
+/**
+ * @brief 设置场景模式
+ *
+ * 在场景注册表中查找 (用户场景优先于内置场景)，未知名称忽略；
+ * "none" 只清除当前场景名。
+ */
+void LampController::applyScene(const char* scene, uint8_t excludeMask) {
+    const SceneSlot slot = m_scenes.lookup(scene);
+    if (slot == kSceneNone) {
+        if (scene && strcasecmp(scene, kSceneNames.name(kSceneNone)) == 0) {
+            m_scene = kSceneNone;
+        } else {
+            Serial.printf("[Lamp] Unknown scene: %s\n", scene ? scene : "");
+        }
+        return;
     }
-    else if (s == "bright") {
-        setCCT(6000, 500, excludeMask);
-        setBrightness(100, 500, excludeMask);
-        m_scene = "Bright";
+    applySceneDef(slot, *m_scenes.at(slot), excludeMask);
+}
+
+/**
+ * @brief 以单个事务应用场景
+ *
+ * 亮度与颜色渐变在同一次调用中启动、使用同一时长与曲线 (亮度不按差值缩放)，
+ * 因此在同一帧开始、同一帧结束。状态只发布一次，随后发送一个 UI_EVENT_SCENE，
+ * 各消费者从快照读取全部目标值。
+ */
+void LampController::applySceneDef(SceneSlot slot, const SceneDef &def, uint8_t excludeMask) {
+    const uint16_t fade = def.fadeMs;
+
+    // 1. 颜色
+    if (def.cctMode) {
+        uint16_t cct = def.cct;
+        if (cct < LAMP_CCT_MIN) cct = LAMP_CCT_MIN;
+        if (cct > LAMP_CCT_MAX) cct = LAMP_CCT_MAX;
+        startCCTFade(cct, fade);
+        m_dirty_cct = true;
+    } else {
+        startColorFade(CRGB(def.r, def.g, def.b), fade);
+        m_dirty_rgb = true;
     }
-    else if (s == "none") {
-        m_scene = "None";
+
+    // 2. 亮度 (关灯时只更新记忆亮度，开灯后生效)
+    uint8_t percent = def.brightness;
+    if (percent < 1) percent = 1;
+    if (percent > 100) percent = 100;
+    m_savedOnBrightness = percent;
+    if (m_on) {
+        const uint32_t target = (uint32_t)map(percent, 1, 100, kMinVisibleBrightness, 100) << 16;
+        if (fade > 0) {
+            m_tween.start(TWEEN_BRIGHTNESS, (int32_t)m_brightnessQ16, (int32_t)target, fade, m_curve);
+        } else {
+            m_tween.cancel(TWEEN_BRIGHTNESS);
+            setBrightnessQ16(target);
+        }
     }
-    
-    // 场景模式通常意味着退出特效
-    if (s != "none") {
-        setEffect(EffectMode::None);
+
+    // 3. 场景意味着退出特效
+    applyEffect(EffectMode::None, EFFECT_CROSSFADE_MS);
+    m_scene = slot;
+    if (fade == 0) update();
+
+    m_dirty_br = true;
+    m_dirty_mode = true;
+    markChanged();
+    publishState();
+
+    UIEvent evt{UI_EVENT_SCENE, (int)def.hash};
+    send_ui_event(evt, excludeMask);
+}
+
+/**
+ * @brief 新建或覆盖用户场景并延迟写入 NVS
+ */
+void LampController::applySceneStore(const SceneDef &def) {
+    if (!m_scenes.store(def)) {
+        Serial.printf("[Lamp] Scene not stored: %s (full or reserved name)\n", def.name);
+        return;
     }
-    
-    // 发送 UI 事件通知状态变更 (这里不再发送 EFFECT 事件，因为 setEffect 会发送)
-    // 如果需要通知 Scene 变更，可能需要新的事件类型，或者复用 EFFECT 事件但带特殊值？
-    // 目前 UI 似乎没有显示当前 Scene 的功能，只显示 Effect。
+    m_dirty_scenes = true;
+    markChanged();
 }
 
-String LampController::getScene() const {
-    return m_scene;
+void LampController::applySceneDelete(const char* name) {
+    if (!m_scenes.remove(name, m_scene)) return;
+    m_dirty_scenes = true;
+    markChanged();
 }
 
-void LampController::setAutoBrightness(bool enable) {
+void LampController::applyAutoBrightness(bool enable) {
     if (m_autoBrightness != enable) {
         m_autoBrightness = enable;
         m_dirty_auto_br = true;
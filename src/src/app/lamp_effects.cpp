@@ -1,133 +1,333 @@
 #include "lamp.hpp"
 #include <FastLED.h>
-#include <math.h>
+#include "lamp_wave.hpp"
+#include "lamp_noise.hpp"
 
 // =================================================================================
 // 特效执行
 // =================================================================================
 
+namespace {
+
+// 特效统一使用 LampLayout 的坐标表；更换面板布局只需修改 lamp_geometry.hpp 中的 LampLayout
+using Geometry = LedGeometry<LampLayout>;
+constexpr const Geometry& kGeo = kLedGeometry<LampLayout>;
+
+constexpr uint16_t kBreathPeriodMs = 4000;
+
+// 流星拖尾衰减：每 10ms 保留 216/256 (即原先每帧 fadeToBlackBy(40) @ 100fps)，
+// kMeteorDecay[k] 为离开 k*10ms 后的剩余亮度 (Q8)。
+constexpr uint32_t kMeteorStepMs = 30;   // 头部每 30ms 前进一列
+constexpr uint32_t kMeteorDecaySteps = 48;
+
+struct DecayTable {
+    uint16_t v[kMeteorDecaySteps + 1];
+};
+
+constexpr DecayTable makeMeteorDecay() {
+    DecayTable t{};
+    uint32_t keep = 256;
+    for (uint32_t k = 0; k <= kMeteorDecaySteps; k++) {
+        t.v[k] = (uint16_t)keep;
+        keep = (keep * 216) >> 8;
+    }
+    return t;
+}
+
+constexpr DecayTable kMeteorDecay = makeMeteorDecay();
+
+/**
+ * @brief 离开 age_ms 后的拖尾亮度 (0-256)，10ms 之间线性插值
+ */
+uint16_t meteor_decay(uint32_t age_ms) {
+    uint32_t k = age_ms / 10;
+    if (k >= kMeteorDecaySteps) return 0;
+    uint32_t frac = age_ms % 10;
+    uint32_t a = kMeteorDecay.v[k];
+    uint32_t b = kMeteorDecay.v[k + 1];
+    return (uint16_t)(a - (a - b) * frac / 10);
+}
+
+// 噪声坐标：一周 4 个格点 (x 方向掩码 3，首尾衔接)，方位角 0-255 乘以格点数即 Q8 坐标
+constexpr uint8_t kNoiseCells = 4;
+
+/**
+ * @brief 单色特效 (Breathing/Meteor) 的颜色
+ *
+ * Solid 调色板即基色 (表尾)；其他调色板约 10 秒走完一遍，颜色缓慢轮换。
+ */
+CRGB effect_color(const CRGB* pal, PaletteId id, uint32_t ms) {
+    return id == PaletteId::Solid ? pal[255] : pal[(uint8_t)(ms / 40)];
+}
+
+/**
+ * @brief 按特效速度缩放帧间隔 (speed 128 = 原速)
+ */
+uint32_t scaled_dt(uint32_t dt_us, uint8_t speed) {
+    return (uint32_t)((uint64_t)dt_us * speed / 128);
+}
+
+/**
+ * @brief 推进一层的时间轴 (ms + 不足 1ms 的余量)
+ */
+void advance_clock(uint32_t &ms, uint16_t &usRem, uint32_t dt_us) {
+    const uint32_t us = dt_us + usRem;
+    ms += us / 1000;
+    usRem = (uint16_t)(us % 1000);
+}
+
 /**
- * @brief 运行当前选定的光效
- * 
- * 在主循环中被调用。根据 m_effect 的值更新 LED 状态。
- * 包含 Rainbow, Breathing, Flow, Spin, Meteor 等效果。
+ * @brief 把 src 按混合方式与不透明度合成到 dst
+ *
+ * 逐字节处理 (CRGB 为 3 字节连续存储)，alpha=255 时 scale8 为恒等。
  */
-void LampController::runEffect() {
-    if (m_effect == EffectMode::None) return;
-    
-    m_effectTick++;
-    uint8_t brightness = m_brightness;
-    
-    switch (m_effect) {
+static_assert(sizeof(CRGB) == 3, "blend_layer 按连续 RGB 字节处理");
+
+void blend_layer(CRGB* dst, const CRGB* src, BlendMode mode, uint8_t alpha) {
+    uint8_t* d = &dst[0].r;
+    const uint8_t* s = &src[0].r;
+    const int n = LAMP_NUM_LEDS * 3;
+
+    switch (mode) {
+        case BlendMode::Alpha:
+            for (int i = 0; i < n; i++) d[i] = scale8(d[i], 255 - alpha) + scale8(s[i], alpha);
+            break;
+        case BlendMode::Add:
+            for (int i = 0; i < n; i++) d[i] = qadd8(d[i], scale8(s[i], alpha));
+            break;
+        case BlendMode::Max:
+            for (int i = 0; i < n; i++) {
+                uint8_t v = scale8(s[i], alpha);
+                if (v > d[i]) d[i] = v;
+            }
+            break;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 按时间轴绘制一层特效
+ *
+ * 输出满亮度像素，亮度缩放统一在 runEffect() 合成后一次完成。
+ * None 以及没有独立画面的模式绘制为当前 CCT/RGB 基色。
+ * 所有特效只依赖传入的时间 ms，与调用频率无关。
+ *
+ * @param mode 特效
+ * @param ms 该层的时间轴 (ms)
+ * @param out LAMP_NUM_LEDS 像素
+ */
+void LampController::renderEffect(EffectMode mode, uint32_t ms, CRGB* out) {
+    const EffectParams &params = m_effectParams[(uint8_t)mode];
+
+    switch (mode) {
         case EffectMode::Rainbow: {
-            uint8_t hue = (m_effectTick * 2) & 0xFF;
-            fill_rainbow(m_leds, LAMP_NUM_LEDS, hue, 7);
-            for(int i=0; i<LAMP_NUM_LEDS; i++) {
-                m_leds[i].nscale8(scaleChannel(255, brightness));
+            // 强度 = 相邻 LED 的色差 (128 时每颗 7)
+            const CRGB* pal = effectPalette(mode);
+            const uint8_t step = params.intensity * 7 / 128;
+            uint8_t hue = (ms / 5) & 0xFF; // 200 hue/s
+            for (int i = 0; i < LAMP_NUM_LEDS; i++) {
+                out[i] = pal[(uint8_t)(hue + i * step)];
             }
             break;
         }
         case EffectMode::Breathing: {
-            // 使用 exp(sin(x)) 产生更自然的呼吸曲线
-            float val = (exp(sin(millis() / 2000.0 * PI)) - 0.36787944) * 108.0;
-            
-            // 限制范围
-            if (val < 0) val = 0;
-            if (val > 255) val = 255;
-            
-            uint8_t breathBri = (uint8_t)val;
-            
-            // 映射到 [50, 255] 区间，确保最低亮度不为 0，防止看起来像熄灭
-            breathBri = map(breathBri, 0, 255, 50, 255);
+            // exp(sin(x)) 呼吸曲线 (定点查表，4s 一个周期)
+            // 强度 = 呼吸深度：128 时映射到 [50, 255]，最低亮度不为 0，防止看起来像熄灭
+            const uint16_t depth = params.intensity * 205u / 128;
+            const uint8_t lo = depth >= 255 ? 0 : 255 - depth;
+            uint8_t breathBri = wave_to_u8(wave_breath(wave_phase(ms, kBreathPeriodMs)), lo, 255);
             
-            uint8_t finalBri = scaleChannel(breathBri, brightness);
-            
-            uint8_t r, g, b;
-            if (m_useCCT) {
-                cctToRawRGB(m_cct, r, g, b);
-            } else {
-                r = m_rgbColor.r; g = m_rgbColor.g; b = m_rgbColor.b;
-            }
-            
-            fill_solid(m_leds, LAMP_NUM_LEDS, CRGB(r, g, b));
-            for(int i=0; i<LAMP_NUM_LEDS; i++) {
-                m_leds[i].nscale8(finalBri);
-            }
+            // 整灯同色：只缩放一次再填充
+            fill_solid(out, LAMP_NUM_LEDS, effect_color(effectPalette(mode), params.palette, ms).nscale8(breathBri));
             break;
         }
         case EffectMode::Police: {
             // 警灯特效: 红蓝旋转 -> 爆闪
-            // 假设 runEffect 约 20ms 调用一次
-            uint32_t cycle = m_effectTick % 400; // 8秒一个大周期
+            uint32_t cycle = ms % 8000; // 8秒一个大周期
             
-            if (cycle < 300) { // 前6秒旋转 (红蓝各半)
-                int offset = ((LAMP_NUM_LEDS / 4) - (cycle / 2) % (LAMP_NUM_LEDS / 4)); // 逆时针旋转
-                for(int i=0; i<LAMP_NUM_LEDS; i++) {
-                    int panel = i / 16;
-                    int local_x = i % 4;
-                    int x = panel * 4 + local_x;
-                    int pos = (x + offset) % (LAMP_NUM_LEDS / 4);
-                    if (pos < LAMP_NUM_LEDS / 8) {
-                        m_leds[i] = CRGB::Red;
-                    } else {
-                        m_leds[i] = CRGB::Blue;
-                    }
+            if (cycle < 6000) { // 前6秒旋转 (红蓝各半)，每 40ms 转过一列
+                // 逆时针旋转：方位角减去已转过的角度，前半圈红、后半圈蓝 (uint8 自然回绕)
+                const uint8_t turned = (uint8_t)((cycle / 40) * 256 / Geometry::kColumns);
+                for (int i = 0; i < Geometry::kNumLeds; i++) {
+                    uint8_t a = kGeo.led[i].angle - turned;
+                    out[i] = (a < 128) ? CRGB::Red : CRGB::Blue;
                 }
             } else { // 后2秒爆闪
-                // 每 5 ticks (100ms) 切换一次状态
-                int flashPhase = (cycle - 300) / 5;
+                // 每 100ms 切换一次状态
+                int flashPhase = (cycle - 6000) / 100;
                 // 模拟警灯爆闪节奏: 红红 蓝蓝 红红 蓝蓝
                 // 0: Red, 1: Off, 2: Red, 3: Off, 4: Blue, 5: Off, 6: Blue, 7: Off ...
                 
                 if (flashPhase % 4 == 0 || flashPhase % 4 == 2) {
-                    fill_solid(m_leds, LAMP_NUM_LEDS, (flashPhase / 8) % 2 == 0 ? CRGB::Red : CRGB::Blue);
+                    fill_solid(out, LAMP_NUM_LEDS, (flashPhase / 8) % 2 == 0 ? CRGB::Red : CRGB::Blue);
                 } else {
-                    fill_solid(m_leds, LAMP_NUM_LEDS, CRGB::Black);
+                    fill_solid(out, LAMP_NUM_LEDS, CRGB::Black);
                 }
             }
-            
-            for(int i=0; i<LAMP_NUM_LEDS; i++) {
-                m_leds[i].nscale8(scaleChannel(255, brightness));
-            }
             break;
         }
         case EffectMode::Spin: {
-            uint8_t baseHue = (m_effectTick * 2) & 0xFF;
-            for(int i=0; i<LAMP_NUM_LEDS; i++) {
-                int panel = i / 16;
-                int local_x = i % 4;
-                int x = panel * 4 + local_x;
-                uint8_t hue = baseHue + (x * 16);
-                m_leds[i] = CHSV(hue, 255, 255);
-                m_leds[i].nscale8(scaleChannel(255, brightness));
+            // 强度 = 绕一周走过的调色板圈数 (128 时恰好走完一遍)
+            const CRGB* pal = effectPalette(mode);
+            uint8_t baseHue = (ms / 5) & 0xFF;
+            for (int i = 0; i < Geometry::kNumLeds; i++) {
+                uint8_t hue = baseHue + (uint8_t)((uint16_t)kGeo.led[i].angle * params.intensity / 128);
+                out[i] = pal[hue];
             }
             break;
         }
         case EffectMode::Meteor: {
-            fadeToBlackBy(m_leds, LAMP_NUM_LEDS, 40);
-            int headX = (m_effectTick / 3) % 16;
+            // 按时间解析计算每列亮度：头部所在列满亮度，其余列按离开时长衰减
+            // 强度 = 拖尾长度：衰减时长按 128/intensity 缩放 (0 = 无拖尾)
+            const uint32_t headStep = ms / kMeteorStepMs;
+            const uint32_t intoStep = ms % kMeteorStepMs;
+            const int headX = headStep % Geometry::kColumns;
+            const CRGB base = effect_color(effectPalette(mode), params.palette, ms);
             
-            uint8_t r, g, b;
-            if (m_useCCT) {
-                cctToRawRGB(m_cct, r, g, b);
-            } else {
-                r = m_rgbColor.r; g = m_rgbColor.g; b = m_rgbColor.b;
+            CRGB column[Geometry::kColumns];
+            for (int x = 0; x < Geometry::kColumns; x++) {
+                int d = (headX - x + Geometry::kColumns) % Geometry::kColumns; // 头部离开该列的步数
+                uint32_t age = (d - 1) * kMeteorStepMs + intoStep;
+                uint16_t keep = (d == 0) ? 256
+                              : (params.intensity == 0) ? 0
+                              : meteor_decay(age * 128 / params.intensity);
+                column[x] = keep ? CRGB(base).nscale8((uint8_t)(keep - 1)) : CRGB::Black;
             }
             
-            for(int i=0; i<LAMP_NUM_LEDS; i++) {
-                int panel = i / 16;
-                int local_x = i % 4;
-                int x = panel * 4 + local_x;
-                if (x == headX) {
-                    m_leds[i] = CRGB(r, g, b);
-                }
-                m_leds[i].nscale8(scaleChannel(255, brightness));
+            for (int i = 0; i < Geometry::kNumLeds; i++) {
+                out[i] = column[kGeo.led[i].x];
+            }
+            break;
+        }
+        case EffectMode::Fire: {
+            // 噪声场随时间向上翻滚 (y 减去时间)，越往上冷却越多，热量查调色板
+            // 强度 = 火焰高度：冷却量按 (256 - intensity) / 128 缩放
+            const CRGB* pal = effectPalette(mode);
+            uint8_t cool[Geometry::kRows];
+            for (int y = 0; y < Geometry::kRows; y++) {
+                uint32_t c = (40u + y * 28u) * (256u - params.intensity) / 128u;
+                cool[y] = c > 255 ? 255 : (uint8_t)c;
+            }
+            const uint16_t rise = (uint16_t)(ms * 3 / 2); // 约 6 格/秒
+            for (int i = 0; i < Geometry::kNumLeds; i++) {
+                const LedCoord &c = kGeo.led[i];
+                uint8_t n = noise2d_fbm((uint16_t)c.angle * kNoiseCells, (uint16_t)c.y * 96 - rise, kNoiseCells - 1);
+                uint8_t heat = qsub8(qadd8(n, n / 2), cool[c.y]); // 拉伸对比度后按高度冷却
+                out[i] = pal[heat];
             }
             break;
         }
+        case EffectMode::Candle: {
+            // 整体亮度由快速变化的时间噪声驱动 (摇曳)，叠加缓慢的局部明暗，上方略暗
+            // 强度 = 摇曳幅度 (128 时亮度在 110-255 之间)
+            const CRGB* pal = effectPalette(mode);
+            const uint16_t amp = params.intensity * 145u / 128;
+            const uint8_t swing = amp > 255 ? 255 : (uint8_t)amp;
+            const uint8_t flicker = noise2d_fbm((uint16_t)(ms * 2), 0x4000);
+            const uint8_t level = 255 - swing + scale8(flicker, swing);
+            const uint16_t drift = (uint16_t)(ms / 4);
+            for (int i = 0; i < Geometry::kNumLeds; i++) {
+                const LedCoord &c = kGeo.led[i];
+                uint8_t local = noise2d((uint16_t)c.angle * kNoiseCells + drift, (uint16_t)c.y * 64, kNoiseCells - 1);
+                uint8_t v = qsub8(scale8(level, 200 + local / 5), c.y * 10);
+                out[i] = pal[v];
+            }
+            break;
+        }
+        case EffectMode::Aurora: {
+            // 两层低频噪声缓慢环绕漂移：一层决定调色板位置 (颜色)，一层决定帘幕亮度
+            // 强度 = 帘幕明暗对比 (128 时最暗处保留 60)
+            const CRGB* pal = effectPalette(mode);
+            const uint16_t contrast = params.intensity * 195u / 128;
+            const uint8_t floor = contrast >= 255 ? 0 : 255 - contrast;
+            const uint16_t drift = (uint16_t)(ms / 8);   // 约 0.5 格/秒
+            const uint16_t evolve = (uint16_t)(ms / 20);
+            for (int i = 0; i < Geometry::kNumLeds; i++) {
+                const LedCoord &c = kGeo.led[i];
+                const uint16_t x = (uint16_t)c.angle * kNoiseCells;
+                uint8_t hue = noise2d(x + drift, (uint16_t)c.y * 40 + evolve, kNoiseCells - 1);
+                uint8_t curtain = noise2d(x - drift / 2, evolve + 0x8000, kNoiseCells - 1);
+                CRGB px = pal[hue];
+                px.nscale8(qadd8(curtain, floor));
+                out[i] = px;
+            }
+            break;
+        }
+        case EffectMode::Image:
+            memcpy(out, m_image, sizeof(m_image));
+            break;
+        case EffectMode::Animation:
+            renderAnimation(ms, out);
+            break;
         default:
+            fill_solid(out, LAMP_NUM_LEDS, baseColor());
             break;
     }
-    
-    FastLED.show();
+
+    // 反向：整帧左右镜像，沿圆周的运动方向随之反转
+    if (params.reverse) {
+        for (int i = 0; i < Geometry::kNumLeds; i++) {
+            const uint16_t j = kGeo.mirror[i];
+            if (j > i) {
+                CRGB t = out[i];
+                out[i] = out[j];
+                out[j] = t;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 特效当前调色板的 256 项表 (PaletteCache 按需展开)
+ */
+const CRGB* LampController::effectPalette(EffectMode mode) {
+    return m_palettes.get(m_effectParams[(uint8_t)mode].palette, baseColor());
+}
+
+// =================================================================================
+// 图层合成
+// =================================================================================
+
+bool LampController::isCompositing() const {
+    if (m_effect != EffectMode::None || m_xfadeAlpha != 255) return true;
+    for (const EffectLayer &l : m_overlays) {
+        if (l.mode != EffectMode::None) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 合成并提交一帧
+ *
+ * 1) 底层 (m_effect) 直接绘制到 m_leds；
+ * 2) 交叉淡化中，旧底层绘制到 m_layerBuf[0] 并按 m_xfadeAlpha 混合；
+ * 3) 叠加层 k 绘制到 m_layerBuf[k]，按各自的 BlendMode/alpha 自下而上混合；
+ * 4) 最后一次遍历缩放到整灯/分区亮度 (scaleOutput)。
+ *
+ * 各层的时间轴独立推进 (按各自特效的 speed 缩放)，叠加层不会因底层切换而重新开始。
+ *
+ * @param dt_us 距上一帧的实际时间 (us)
+ */
+void LampController::runEffect(uint32_t dt_us) {
+    advance_clock(m_effectMs, m_effectUsRem, scaled_dt(dt_us, m_effectParams[(uint8_t)m_effect].speed));
+    renderEffect(m_effect, m_effectMs, m_leds);
+
+    if (m_xfadeAlpha != 255) {
+        advance_clock(m_xfadeFrom.ms, m_xfadeFrom.usRem, scaled_dt(dt_us, m_effectParams[(uint8_t)m_xfadeFrom.mode].speed));
+        renderEffect(m_xfadeFrom.mode, m_xfadeFrom.ms, m_layerBuf[0]);
+        // 旧底层按剩余权重盖在新底层上，淡化进度越大旧画面越淡
+        blend_layer(m_leds, m_layerBuf[0], BlendMode::Alpha, 255 - m_xfadeAlpha);
+    }
+
+    for (uint8_t k = 1; k < MAX_LAYERS; k++) {
+        EffectLayer &l = m_overlays[k - 1];
+        if (l.mode == EffectMode::None) continue;
+        advance_clock(l.ms, l.usRem, scaled_dt(dt_us, m_effectParams[(uint8_t)l.mode].speed));
+        renderEffect(l.mode, l.ms, m_layerBuf[k]);
+        blend_layer(m_leds, m_layerBuf[k], l.blend, l.alpha);
+    }
+
+    scaleOutput();
+    presentFrame();
 }
@@ -9,12 +9,14 @@
  * 
  * @param targetPercent 目标亮度 (0-100)
  * @param duration_ms 渐变持续时间 (ms)
+ * @param scaleByDistance true 时 duration_ms 视为 0-100 全程的时长，按实际亮度差缩放 (开关灯的默认渐变)；
+ *                        false 时按给定时长执行 (调用方指定的日出/睡眠等长渐变)
  */
-void LampController::fadeToBrightness(uint8_t targetPercent, uint16_t duration_ms) {
+void LampController::fadeToBrightness(uint8_t targetPercent, uint32_t duration_ms, bool scaleByDistance) {
     if (targetPercent > 100) targetPercent = 100;
 
     uint8_t diff = (targetPercent > m_brightness) ? (targetPercent - m_brightness) : (m_brightness - targetPercent);
-    uint32_t actual_duration = ((uint32_t)duration_ms * diff) / 100;
+    uint32_t actual_duration = scaleByDistance ? (uint32_t)(((uint64_t)duration_ms * diff) / 100) : duration_ms;
     
     // 避免时间过短
     if (actual_duration < 50 && diff > 0 && duration_ms > 0) actual_duration = 50;
@@ -23,17 +25,16 @@ void LampController::fadeToBrightness(uint8_t targetPercent, uint16_t duration_m
     // 修复：如果目标亮度很低（例如关灯），确保渐变能执行到底
     // 原逻辑可能因为 diff 小导致 actual_duration 很短，或者步进计算问题
     
-    m_targetBrightness = targetPercent;
-    m_fadeDurationMs = (uint16_t)actual_duration;
-    m_fadeActive = true;
+    // 亮度轨道以 Q16 推进，每帧都有小数进度供 ditheredPwm() 使用
+    m_tween.start(TWEEN_BRIGHTNESS, (int32_t)m_brightnessQ16, (int32_t)targetPercent << 16, actual_duration, m_curve);
 }
 
 void LampController::cancelFade() { 
-    m_fadeActive = false; 
+    m_tween.cancel(TWEEN_BRIGHTNESS); 
 }
 
 bool LampController::isFading() const { 
-    return m_fadeActive; 
+    return m_tween.isActive(TWEEN_BRIGHTNESS); 
 }
 
 void LampController::setFadeCurve(FadeCurve curve) { 
@@ -44,106 +45,128 @@ FadeCurve LampController::getFadeCurve() const {
     return m_curve; 
 }
 
-bool LampController::advanceFade(uint32_t &elapsed, uint8_t &start) {
-    if (m_brightness == m_targetBrightness || m_fadeDurationMs == 0) {
-        m_brightness = m_targetBrightness;
-        update();
-        m_fadeActive = false;
-        start = m_brightness;
-        elapsed = 0;
-        return false;
-    }
+void LampController::setColorSpace(ColorSpace space) {
+    m_colorSpace = space;
+}
 
-    elapsed += STEP_MS;
-    if (elapsed >= m_fadeDurationMs) elapsed = m_fadeDurationMs;
+ColorSpace LampController::getColorSpace() const {
+    return m_colorSpace;
+}
 
-    uint32_t t_q16 = (uint32_t)(((uint64_t)elapsed << 16) / m_fadeDurationMs);
-    t_q16 = applyEasing(t_q16);
+/**
+ * @brief 从当前 m_rgbColor 渐变到 target
+ *
+ * 端点在 m_colorSpace 中预先转换一次，TWEEN_COLOR 轨道只推进 0-65536 的进度，
+ * 每帧由 ColorFade 插值并转换回 sRGB。
+ */
+void LampController::startRGBTween(const CRGB &target, uint32_t fade_ms) {
+    m_colorFade.begin(m_colorSpace, m_rgbColor, target);
+    m_tween.start(TWEEN_COLOR, 0, 65536, fade_ms, m_curve);
+}
 
-    int16_t delta = (int16_t)m_targetBrightness - (int16_t)start;
-    
-    // 使用更精确的计算，避免低亮度时的截断误差
-    // 将计算域扩大，最后再缩小
-    int32_t val = (int32_t)start * 65536 + (int32_t)delta * (int32_t)t_q16;
-    uint8_t cur = (uint8_t)(val >> 16);
-    
-    if (cur != m_brightness) {
-        m_brightness = cur;
-        update();
-    }
+void LampController::cancelColorTweens() {
+    m_tween.cancel(TWEEN_CCT);
+    m_tween.cancel(TWEEN_COLOR);
+}
 
-    if (elapsed >= m_fadeDurationMs) {
-        if (m_brightness != m_targetBrightness) {
-            m_brightness = m_targetBrightness;
-            update();
+/**
+ * @brief 渐变引擎步进，把变化的轨道值写回灯光状态
+ *
+ * 各轨道独立推进：颜色渐变进行中再调亮度不会重置颜色进度，反之亦然。
+ *
+ * @param dt_us 流逝时间 (us)；不足 1ms 的部分累积到下一次
+ */
+void LampController::advanceTweens(uint32_t dt_us) {
+    const uint32_t us = dt_us + m_tweenUsRem;
+    m_tweenUsRem = us % 1000;
+
+    TweenEngine::Update updates[TweenEngine::kMaxTracks];
+    uint8_t n = m_tween.step(us / 1000, updates);
+    if (n == 0) return;
+
+    for (uint8_t i = 0; i < n; i++) {
+        const int32_t v = updates[i].value;
+        switch (updates[i].key) {
+            case TWEEN_BRIGHTNESS: setBrightnessQ16((uint32_t)v); break;
+            case TWEEN_CCT:        m_cct = (uint16_t)v; break;
+            case TWEEN_COLOR:      m_rgbColor = m_colorFade.at((uint32_t)v); break;
+            case TWEEN_CROSSFADE:  m_xfadeAlpha = (uint8_t)v; break;
+            default: {
+                const uint8_t key = updates[i].key;
+                if (key >= TWEEN_ZONE_COLOR && key < TWEEN_ZONE_COLOR + LAMP_NUM_ZONES) {
+                    Zone &z = m_zones[key - TWEEN_ZONE_COLOR];
+                    z.color = z.fade.at((uint32_t)v);
+                } else if (key >= TWEEN_ZONE_LEVEL && key < TWEEN_ZONE_LEVEL + LAMP_NUM_ZONES) {
+                    m_zones[key - TWEEN_ZONE_LEVEL].levelQ16 = (uint32_t)v;
+                }
+                break;
+            }
         }
-        
-        m_fadeActive = false;
-        start = m_brightness;
-        elapsed = 0;
-        return false;
     }
-    return true;
-}
-
-bool LampController::advanceColorFade(uint32_t &elapsed) {
-    elapsed += STEP_MS;
-    if (elapsed >= m_colorFadeDurationMs) elapsed = m_colorFadeDurationMs;
-
-    uint32_t t_q16 = (uint32_t)(((uint64_t)elapsed << 16) / m_colorFadeDurationMs);
-    t_q16 = applyEasing(t_q16);
+    finishZoneTweens();
 
-    if (m_useCCT) {
-        int32_t delta = (int32_t)m_targetCCT - (int32_t)m_startCCT;
-        m_cct = (uint16_t)(m_startCCT + ((delta * (int32_t)t_q16) >> 16));
-    } else {
-        m_rgbColor.r = m_startRGB.r + ((((int16_t)m_targetRGB.r - m_startRGB.r) * (int32_t)t_q16) >> 16);
-        m_rgbColor.g = m_startRGB.g + ((((int16_t)m_targetRGB.g - m_startRGB.g) * (int32_t)t_q16) >> 16);
-        m_rgbColor.b = m_startRGB.b + ((((int16_t)m_targetRGB.b - m_startRGB.b) * (int32_t)t_q16) >> 16);
+    // RGB -> CCT：到达目标色温的 RGB 后切回 CCT 模式
+    if (m_fadingToCCT && !m_tween.isActive(TWEEN_COLOR)) {
+        m_useCCT = true;
+        m_cct = m_targetCCT;
+        m_fadingToCCT = false;
     }
 
     update();
-
-    if (elapsed >= m_colorFadeDurationMs) {
-        if (m_fadingToCCT) {
-            m_useCCT = true;
-            m_cct = m_targetCCT;
-            m_fadingToCCT = false;
-        } else if (m_useCCT) {
-            m_cct = m_targetCCT;
-        } else {
-            m_rgbColor = m_targetRGB;
-        }
-        update();
-
-        m_colorFadeActive = false;
-        elapsed = 0;
-        return false;
-    }
-    return true;
 }
 
-uint32_t LampController::applyEasing(uint32_t t) const {
-    if (t == 0) return 0;
-    if (t >= 65535) return 65535;
-    
-    switch (m_curve) {
-        case FadeCurve::Linear:
-            return t;
-        case FadeCurve::EaseIn:
-            return (uint32_t)(((uint64_t)t * t) >> 16);
-        case FadeCurve::EaseOut: {
-            uint32_t u = 65535u - t;
-            return 65535u - (uint32_t)(((uint64_t)u * u) >> 16);
-        }
-        case FadeCurve::EaseInOut:
-        case FadeCurve::Smoothstep: {
-            uint64_t t_64 = t;
-            uint64_t t2 = (t_64 * t_64) >> 16;
-            uint64_t t3 = (t2 * t_64) >> 16;
-            return (uint32_t)((3 * t2) - (2 * t3));
+/**
+ * @brief 轨道值 from -> to 是否改变实际输出 (静态模式下的 LED 颜色或上报的整数亮度)
+ *
+ * 亮度按四舍五入后的 PWM 比较，颜色按转换后的 RGB 比较：长渐变中色温每变几 K、
+ * 亮度每变零点几个百分点才对应一次输出变化。
+ */
+bool LampController::tweenOutputChanged(void* ctx, uint8_t key, int32_t from, int32_t to) {
+    LampController* self = static_cast<LampController*>(ctx);
+    switch (key) {
+        case TWEEN_BRIGHTNESS:
+            return ((from + 0x8000) >> 16) != ((to + 0x8000) >> 16) ||
+                   roundedPwm((uint32_t)from) != roundedPwm((uint32_t)to);
+        case TWEEN_CCT: {
+            uint8_t r0, g0, b0, r1, g1, b1;
+            self->cctToRawRGB((uint16_t)from, r0, g0, b0);
+            self->cctToRawRGB((uint16_t)to, r1, g1, b1);
+            return r0 != r1 || g0 != g1 || b0 != b1;
         }
+        case TWEEN_COLOR:
+            return self->m_colorFade.at((uint32_t)from) != self->m_colorFade.at((uint32_t)to);
         default:
-            return t;
+            if (key >= TWEEN_ZONE_COLOR && key < TWEEN_ZONE_COLOR + LAMP_NUM_ZONES) {
+                const ColorFade &fade = self->m_zones[key - TWEEN_ZONE_COLOR].fade;
+                return fade.at((uint32_t)from) != fade.at((uint32_t)to);
+            }
+            if (key >= TWEEN_ZONE_LEVEL && key < TWEEN_ZONE_LEVEL + LAMP_NUM_ZONES) {
+                Zone z = self->m_zones[key - TWEEN_ZONE_LEVEL];
+                z.levelQ16 = (uint32_t)from;
+                const uint8_t pwm0 = roundedPwm(self->zoneBrightnessQ16(z));
+                z.levelQ16 = (uint32_t)to;
+                return pwm0 != roundedPwm(self->zoneBrightnessQ16(z));
+            }
+            return from != to;
     }
 }
+
+/**
+ * @brief 决定下一帧的渐变调度方式
+ *
+ * 特效/实时流期间本就按帧推进；静态模式下若输出在 TWEEN_SLEEP_MIN_MS 内都不会变化
+ * (如 30 分钟日出，约每几秒才变一级 PWM)，则置 m_tweenSleep，LampTask 休眠到下一次变化。
+ * 刚进入休眠时按四舍五入 PWM 重绘一次，避免停在抖动中的某一帧上。
+ */
+void LampController::scheduleTweens() {
+    const bool wasSleeping = m_tweenSleep;
+    m_tweenSleep = false;
+    if (!m_tween.anyActive() || isCompositing() || m_streamActive) return;
+
+    const uint32_t wait = m_tween.nextChangeMs(TWEEN_SLEEP_MIN_MS, tweenOutputChanged, this);
+    if (wait == 0) return;
+
+    m_tweenSleep = true;
+    m_tweenWaitMs = wait < TWEEN_MAX_SLEEP_MS ? wait : TWEEN_MAX_SLEEP_MS;
+    if (!wasSleeping) update();
+}
@@ -0,0 +1,96 @@
+#include "lamp_frame.hpp"
+
+// =================================================================================
+// 帧解码 (BLE / MQTT / 动画文件共用)
+// =================================================================================
+
+namespace {
+
+/**
+ * @brief 读取调色板头 [n][n x r,g,b]
+ *
+ * @return 调色板之后的偏移；格式错误返回 0
+ */
+size_t read_palette(const uint8_t* data, size_t len, const uint8_t* &pal, uint16_t &n) {
+    if (len < 1) return 0;
+    n = data[0] ? data[0] : 256; // 0 表示 256 色
+    const size_t end = 1 + (size_t)n * 3;
+    if (end > len) return 0;
+    pal = data + 1;
+    return end;
+}
+
+inline void put(CRGB* out, uint8_t i, const uint8_t* rgb) {
+    if (out) out[i] = CRGB(rgb[0], rgb[1], rgb[2]);
+}
+
+bool decode_raw(const uint8_t* data, size_t len, CRGB* out) {
+    if (len != FRAME_PIXELS * 3) return false;
+    for (uint8_t i = 0; i < FRAME_PIXELS; i++) put(out, i, data + i * 3);
+    return true;
+}
+
+bool decode_palette(const uint8_t* data, size_t len, CRGB* out) {
+    const uint8_t* pal = nullptr;
+    uint16_t n = 0;
+    size_t pos = read_palette(data, len, pal, n);
+    if (pos == 0) return false;
+
+    const uint8_t bits = n <= 2 ? 1 : n <= 4 ? 2 : n <= 16 ? 4 : 8;
+    if (len - pos != (size_t)FRAME_PIXELS * bits / 8) return false;
+
+    const uint8_t mask = (uint8_t)((1u << bits) - 1);
+    const uint8_t perByte = 8 / bits;
+    for (uint8_t i = 0; i < FRAME_PIXELS; i++) {
+        const uint8_t idx = (data[pos + i / perByte] >> ((i % perByte) * bits)) & mask;
+        if (idx >= n) return false;
+        put(out, i, pal + idx * 3);
+    }
+    return true;
+}
+
+bool decode_rle(const uint8_t* data, size_t len, CRGB* out) {
+    uint8_t i = 0;
+    size_t pos = 0;
+    while (pos < len) {
+        if (len - pos < 4) return false;
+        const uint8_t count = data[pos];
+        if (count == 0 || count > FRAME_PIXELS - i) return false;
+        for (uint8_t k = 0; k < count; k++) put(out, i++, data + pos + 1);
+        pos += 4;
+    }
+    return i == FRAME_PIXELS;
+}
+
+bool decode_palette_rle(const uint8_t* data, size_t len, CRGB* out) {
+    const uint8_t* pal = nullptr;
+    uint16_t n = 0;
+    size_t pos = read_palette(data, len, pal, n);
+    if (pos == 0) return false;
+
+    uint8_t i = 0;
+    while (pos < len) {
+        if (len - pos < 2) return false;
+        const uint8_t count = data[pos];
+        const uint8_t idx = data[pos + 1];
+        if (count == 0 || count > FRAME_PIXELS - i || idx >= n) return false;
+        for (uint8_t k = 0; k < count; k++) put(out, i++, pal + idx * 3);
+        pos += 2;
+    }
+    return i == FRAME_PIXELS;
+}
+
+} // namespace
+
+bool frame_decode(const uint8_t* data, size_t len, CRGB* out) {
+    if (data == nullptr || len < 1) return false;
+    const uint8_t* body = data + 1;
+    const size_t bodyLen = len - 1;
+    switch ((FrameEncoding)data[0]) {
+        case FrameEncoding::Raw:        return decode_raw(body, bodyLen, out);
+        case FrameEncoding::Palette:    return decode_palette(body, bodyLen, out);
+        case FrameEncoding::Rle:        return decode_rle(body, bodyLen, out);
+        case FrameEncoding::PaletteRle: return decode_palette_rle(body, bodyLen, out);
+        default:                        return false;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <FastLED.h>
+
+// =================================================================================
+// 二进制帧指令 (任意画面 / 短动画上传)
+// =================================================================================
+//
+// 一条指令 = 一次 BLE 写入 (MTU 247 - ATT 头 3 = 244 字节) 或一条 MQTT 消息 (<base>/frame)：
+//
+//   [0xFB][op][...]
+//   op 0 Show       [enc][数据]                 立即显示静止画面 (切换到 Image 特效)
+//   op 1 AnimBegin                              开始上传动画 (写入临时文件)
+//   op 2 AnimFrame  [时长 ms 低][高][enc][数据]  追加一帧
+//   op 3 AnimEnd                                上传完成，替换已存动画并开始循环播放 (切换到 Animation 特效)
+//
+// 编码 (enc) 与数据，均解码为 FRAME_PIXELS 个像素：
+//   0 Raw         r,g,b x 64                                      (192 字节)
+//   1 Palette     [n][n x r,g,b][索引]，n 为 0 表示 256 色；n <= 16 时每索引 1/2/4 位紧凑排列 (低位在前)，否则 8 位
+//   2 Rle         ([count][r][g][b])...，count 1-64，总数须为 64
+//   3 PaletteRle  [n][n x r,g,b]([count][index])...
+//
+// 首字节 0xFB 不是可打印字符，BLE 端据此与以 '\n' 结尾的文本指令区分。
+
+static constexpr uint8_t FRAME_MAGIC = 0xFB;
+static constexpr uint8_t FRAME_PIXELS = 64;
+static constexpr size_t FRAME_MAX_PACKET = 244;
+
+enum class FrameOp : uint8_t {
+    Show = 0,
+    AnimBegin,
+    AnimFrame,
+    AnimEnd
+};
+
+enum class FrameEncoding : uint8_t {
+    Raw = 0,
+    Palette,
+    Rle,
+    PaletteRle
+};
+
+/**
+ * @brief 解码一帧 (从编码字节开始)
+ *
+ * 数据必须恰好覆盖 FRAME_PIXELS 个像素，索引不得越界，末尾不得有多余字节。
+ *
+ * @param out 输出像素；为 nullptr 时只做校验
+ * @return false 表示格式错误 (out 可能已被部分写入，调用方应先校验)
+ */
+bool frame_decode(const uint8_t* data, size_t len, CRGB* out);
@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+
+// =================================================================================
+// LED 几何布局 (编译期)
+// =================================================================================
+
+// 单颗 LED 的坐标
+struct LedCoord {
+    uint8_t x;     // 列 (绕圆柱一周 0 .. kColumns-1)
+    uint8_t y;     // 行 (自下而上 0 .. kRows-1)
+    uint8_t angle; // 方位角，一周 = 256
+    uint8_t ring;  // 所在环 (同一行的 LED 组成一环)
+};
+
+/**
+ * @brief 面板拼接布局
+ *
+ * Panels 块面板依次围成圆柱，每块 PanelCols 列、PanelRows 行，
+ * 面板内按行优先走线 (先填满一行的 PanelCols 列)。
+ */
+template <uint8_t Panels, uint8_t PanelCols, uint8_t PanelRows>
+struct PanelLayout {
+    static constexpr uint8_t kPanels = Panels;
+    static constexpr uint16_t kPanelLeds = PanelCols * PanelRows;
+    static constexpr uint16_t kNumLeds = Panels * kPanelLeds;
+    static constexpr uint8_t kColumns = Panels * PanelCols;
+    static constexpr uint8_t kRows = PanelRows;
+
+    static constexpr LedCoord coord(uint16_t i) {
+        const uint8_t panel = i / kPanelLeds;
+        const uint8_t local = i % kPanelLeds;
+        const uint8_t x = panel * PanelCols + local % PanelCols;
+        const uint8_t y = local / PanelCols;
+        return LedCoord{x, y, (uint8_t)((uint16_t)x * 256 / kColumns), y};
+    }
+};
+
+// 当前硬件：4 块 4x4 WS2812 面板围成圆柱 (16 列 x 4 行)
+using LampLayout = PanelLayout<4, 4, 4>;
+
+/**
+ * @brief 布局的逐 LED 坐标表，编译期生成，特效热循环中直接查表
+ */
+template <typename Layout>
+struct LedGeometry {
+    static constexpr uint16_t kNumLeds = Layout::kNumLeds;
+    static constexpr uint8_t kColumns = Layout::kColumns;
+    static constexpr uint8_t kRows = Layout::kRows;
+
+    LedCoord led[Layout::kNumLeds];
+    uint16_t mirror[Layout::kNumLeds]; // 左右镜像 (x -> kColumns-1-x，同一行) 后对应的 LED 序号
+};
+
+template <typename Layout>
+constexpr LedGeometry<Layout> makeLedGeometry() {
+    LedGeometry<Layout> g{};
+    for (uint16_t i = 0; i < Layout::kNumLeds; i++) g.led[i] = Layout::coord(i);
+    for (uint16_t i = 0; i < Layout::kNumLeds; i++) {
+        for (uint16_t j = 0; j < Layout::kNumLeds; j++) {
+            if (g.led[j].y == g.led[i].y && g.led[j].x == Layout::kColumns - 1 - g.led[i].x) g.mirror[i] = j;
+        }
+    }
+    return g;
+}
+
+template <typename Layout>
+inline constexpr LedGeometry<Layout> kLedGeometry = makeLedGeometry<Layout>();
@@ -0,0 +1,188 @@
+#include "lamp.hpp"
+#include "../system/file_store.hpp"
+#include <string.h>
+
+// =================================================================================
+// Image / Animation 特效：上传的静止画面 / 循环动画
+//
+// 静止画面：调用方任务校验后持 m_mutex 直接解码进 m_image，再投递 setEffect(Image)。
+// 动画：每帧解码后转码为相对上一帧的增量 (格式见 lamp_anim.hpp)，追加到文件存储中的临时文件，
+// 上传完成后回填帧数并替换 kAnimPath。播放时 LampTask 按特效时间轴经 AnimReader 每次只解码
+// 一帧进 m_animFrame，只占用一个文件句柄和 64 字节预读缓冲，不整体载入内存。
+// =================================================================================
+
+namespace {
+
+constexpr const char* kAnimPath = "/anim.bin";
+constexpr const char* kAnimTmpPath = "/anim.tmp";
+constexpr uint16_t kMaxAnimFrames = 1024;
+constexpr uint32_t kMaxAnimBytes = 64 * 1024;
+constexpr uint8_t kMaxCatchUpFrames = 8; // 单帧内最多追赶的动画帧数 (时长过短或时间跳变时)
+constexpr uint32_t kUploadIdleMs = 10000; // 发起方超过此时长无指令时，允许另一来源重新开始上传
+
+// 上传状态 (m_uploadMutex 保护)：同一时间只接受一路上传，其他来源在 AnimEnd 前被拒绝
+File s_upload;
+uint8_t s_uploadOwner = 0;
+uint32_t s_uploadLastMs = 0;
+uint16_t s_uploadFrames = 0;
+uint32_t s_uploadBytes = 0;
+CRGB s_uploadPrev[FRAME_PIXELS];         // 上一帧 (增量编码的基准)
+
+} // namespace
+
+/**
+ * @brief 处理一条二进制帧指令 (可从任意任务调用)
+ *
+ * @return false 表示格式错误、存储不可用、超出动画大小限制或另一来源的上传正在进行
+ */
+bool LampController::handleFramePacket(const uint8_t* data, size_t len, uint8_t source) {
+    if (data == nullptr || len < 2 || len > FRAME_MAX_PACKET || data[0] != FRAME_MAGIC) return false;
+    const uint8_t* body = data + 2;
+    const size_t bodyLen = len - 2;
+
+    switch ((FrameOp)data[1]) {
+        case FrameOp::Show: {
+            if (!frame_decode(body, bodyLen, nullptr)) return false;
+            if (m_mutex == nullptr || !xSemaphoreTake(m_mutex, portMAX_DELAY)) return false;
+            frame_decode(body, bodyLen, m_image);
+            xSemaphoreGive(m_mutex);
+            setEffect(EffectMode::Image);
+            return true;
+        }
+
+        case FrameOp::AnimBegin:
+        case FrameOp::AnimFrame:
+        case FrameOp::AnimEnd: {
+            if (m_uploadMutex == nullptr || !xSemaphoreTake(m_uploadMutex, portMAX_DELAY)) return false;
+            const bool ok = handleAnimUpload((FrameOp)data[1], body, bodyLen, source);
+            xSemaphoreGive(m_uploadMutex);
+            return ok;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 动画上传指令 (调用方持 m_uploadMutex)
+ *
+ * 上传进行中时只接受发起方的指令；发起方空闲超过 kUploadIdleMs (如 BLE 断开) 后，
+ * 其他来源的 AnimBegin 可以放弃未完成的上传并重新开始。
+ */
+bool LampController::handleAnimUpload(FrameOp op, const uint8_t* body, size_t len, uint8_t source) {
+    const uint32_t now = millis();
+    if (s_upload && s_uploadOwner != source &&
+        (op != FrameOp::AnimBegin || now - s_uploadLastMs < kUploadIdleMs)) {
+        return false;
+    }
+    if (op != FrameOp::AnimBegin && !s_upload) return false;
+    s_uploadLastMs = now;
+
+    switch (op) {
+        case FrameOp::AnimBegin: {
+            if (!file_store_ready()) return false;
+            s_upload.close();
+            s_upload = LittleFS.open(kAnimTmpPath, "w");
+            s_uploadOwner = source;
+            s_uploadFrames = 0;
+            s_uploadBytes = ANIM_HEADER_SIZE;
+            fill_solid(s_uploadPrev, FRAME_PIXELS, CRGB::Black);
+            uint8_t hdr[ANIM_HEADER_SIZE];
+            anim_make_header(hdr, 0); // 帧数在 AnimEnd 时回填
+            return s_upload && s_upload.write(hdr, sizeof(hdr)) == sizeof(hdr);
+        }
+
+        case FrameOp::AnimFrame: {
+            if (len < 3) return false;
+            CRGB cur[FRAME_PIXELS];
+            if (!frame_decode(body + 2, len - 2, cur)) return false;
+
+            uint8_t rec[ANIM_FRAME_HEADER_SIZE + ANIM_MAX_FRAME_BYTES];
+            const size_t n = anim_encode_delta(s_uploadPrev, cur, rec + ANIM_FRAME_HEADER_SIZE, ANIM_MAX_FRAME_BYTES);
+            const uint32_t recLen = ANIM_FRAME_HEADER_SIZE + n;
+            if (n == 0 || s_uploadFrames >= kMaxAnimFrames || s_uploadBytes + recLen > kMaxAnimBytes) return false;
+
+            rec[0] = body[0];
+            rec[1] = body[1];
+            rec[2] = (uint8_t)(n & 0xFF);
+            rec[3] = (uint8_t)(n >> 8);
+            if (s_upload.write(rec, recLen) != recLen) return false;
+            memcpy(s_uploadPrev, cur, sizeof(cur));
+            s_uploadFrames++;
+            s_uploadBytes += recLen;
+            return true;
+        }
+
+        case FrameOp::AnimEnd: {
+            const uint8_t count[2] = {(uint8_t)(s_uploadFrames & 0xFF), (uint8_t)(s_uploadFrames >> 8)};
+            const bool written = s_uploadFrames > 0 && s_upload.seek(ANIM_FRAME_COUNT_OFFSET) &&
+                                 s_upload.write(count, sizeof(count)) == sizeof(count);
+            s_upload.close();
+            s_uploadOwner = 0;
+            if (!written) {
+                LittleFS.remove(kAnimTmpPath);
+                return false;
+            }
+            // 播放中的旧动画先关闭再替换
+            if (m_mutex == nullptr || !xSemaphoreTake(m_mutex, portMAX_DELAY)) return false;
+            m_anim.close();
+            LittleFS.remove(kAnimPath);
+            const bool ok = LittleFS.rename(kAnimTmpPath, kAnimPath);
+            xSemaphoreGive(m_mutex);
+            if (!ok) return false;
+
+            Serial.printf("[Lamp] Animation stored: %u frames, %u bytes\n", s_uploadFrames, (unsigned)s_uploadBytes);
+            setEffect(EffectMode::Animation);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 选择 Animation 特效 (LampTask)：已存动画从第一帧开始
+ */
+void LampController::beginAnimation() {
+    m_animFrameEndMs = 0;
+    fill_solid(m_animFrame, LAMP_NUM_LEDS, CRGB::Black);
+    if (m_anim) {
+        if (!m_anim.rewind()) m_anim.close();
+    } else if (file_store_ready() && LittleFS.exists(kAnimPath)) {
+        if (!m_anim.open(LittleFS, kAnimPath)) Serial.println("[Lamp] Animation file invalid");
+    }
+}
+
+/**
+ * @brief 解码下一帧到 m_animFrame，到达文件末尾时清黑并回到第一帧
+ */
+bool LampController::readAnimFrame() {
+    uint16_t dur = 0;
+    AnimReader::Result res = m_anim.readFrame(m_animFrame, dur);
+    if (res == AnimReader::Result::End) {
+        fill_solid(m_animFrame, LAMP_NUM_LEDS, CRGB::Black);
+        if (!m_anim.rewind()) return false;
+        res = m_anim.readFrame(m_animFrame, dur);
+    }
+    if (res != AnimReader::Result::Ok) return false;
+    m_animFrameEndMs += dur;
+    return true;
+}
+
+/**
+ * @brief 绘制 Animation 特效 (满亮度)；按特效时间轴 (受 speed 缩放) 推进
+ */
+void LampController::renderAnimation(uint32_t ms, CRGB* out) {
+    if (m_anim) {
+        for (uint8_t n = 0; ms >= m_animFrameEndMs && n < kMaxCatchUpFrames; n++) {
+            if (!readAnimFrame()) {
+                Serial.println("[Lamp] Animation file corrupt, stopped");
+                m_anim.close();
+                break;
+            }
+        }
+    }
+    memcpy(out, m_animFrame, sizeof(m_animFrame));
+}
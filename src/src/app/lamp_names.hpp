@@ -0,0 +1,101 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <strings.h>
+
+// =================================================================================
+// 名称表 (编译期完美哈希)
+// =================================================================================
+//
+// 特效名、场景名等“名称 <-> 小整数”映射的唯一来源，MQTT / BLE / HA 发现 / UI 共用。
+// 编译期为名称集合搜索一个种子，使 name_hash(name, seed) % Slots 互不冲突；
+// 运行时查找 = 一次哈希 + 一次 strcasecmp 确认，不分配堆内存。
+// 显示名 (如 "Rainbow") 即表中的字符串，查找不区分大小写。
+
+/**
+ * @brief 名称哈希 (FNV-1a，ASCII 不区分大小写)
+ *
+ * @param basis 偏移基数；默认值即标准 FNV-1a (场景哈希已持久化，不可更改)
+ */
+constexpr uint32_t name_hash(const char* s, uint32_t basis = 2166136261u) {
+    uint32_t h = basis;
+    for (; *s; s++) {
+        char c = *s;
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        h = (h ^ (uint8_t)c) * 16777619u;
+    }
+    return h;
+}
+
+template <uint8_t N, uint8_t Slots>
+class NameTable {
+    static_assert(N > 0 && N <= Slots && Slots < 0xFF, "名称表槽数须不少于名称数");
+
+public:
+    static constexpr uint8_t kNotFound = 0xFF;
+
+    constexpr explicit NameTable(const char* const (&names)[N]) : m_names{}, m_slot{}, m_basis(0) {
+        for (uint8_t i = 0; i < N; i++) m_names[i] = names[i];
+        // 逐个尝试偏移基数，直到所有名称落在不同的槽
+        for (uint32_t seed = 1; seed < 4096 && m_basis == 0; seed++) {
+            const uint32_t basis = 2166136261u ^ (seed * 0x9E3779B9u);
+            for (uint8_t s = 0; s < Slots; s++) m_slot[s] = kNotFound;
+            bool ok = true;
+            for (uint8_t i = 0; i < N && ok; i++) {
+                const uint8_t s = slotOf(name_hash(names[i], basis));
+                if (m_slot[s] != kNotFound) ok = false;
+                else m_slot[s] = i;
+            }
+            if (ok) m_basis = basis;
+        }
+    }
+
+    /** @brief 是否找到无冲突的种子 (供 static_assert 使用) */
+    constexpr bool valid() const { return m_basis != 0; }
+
+    static constexpr uint8_t size() { return N; }
+
+    /** @brief 序号 -> 显示名，越界返回第 0 项 */
+    constexpr const char* name(uint8_t id) const { return m_names[id < N ? id : 0]; }
+
+    /** @brief 名称 -> 序号 (不区分大小写)，未知名称返回 kNotFound */
+    uint8_t find(const char* s) const {
+        if (s == nullptr) return kNotFound;
+        const uint8_t id = m_slot[slotOf(name_hash(s, m_basis))];
+        if (id == kNotFound || strcasecmp(m_names[id], s) != 0) return kNotFound;
+        return id;
+    }
+
+    /**
+     * @brief 写出 JSON 字符串数组 ["A","B",...] (HA select 的 options)
+     *
+     * @return 写入的长度；缓冲区不足时截断为空数组
+     */
+    size_t toJson(char* buf, size_t len) const {
+        size_t n = 0;
+        auto put = [&](char c) { if (n + 1 < len) buf[n] = c; n++; };
+        put('[');
+        for (uint8_t i = 0; i < N; i++) {
+            if (i != 0) put(',');
+            put('"');
+            for (const char* p = m_names[i]; *p; p++) put(*p);
+            put('"');
+        }
+        put(']');
+        if (n + 1 > len) {
+            if (len >= 3) { buf[0] = '['; buf[1] = ']'; buf[2] = '\0'; return 2; }
+            if (len) buf[0] = '\0';
+            return 0;
+        }
+        buf[n] = '\0';
+        return n;
+    }
+
+private:
+    // FNV-1a 的低位只取决于各字符的低位，先折叠高 16 位再取模
+    static constexpr uint8_t slotOf(uint32_t h) { return (uint8_t)((h ^ (h >> 16)) % Slots); }
+
+    const char* m_names[N];
+    uint8_t m_slot[Slots];
+    uint32_t m_basis;
+};
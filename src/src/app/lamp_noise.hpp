@@ -0,0 +1,83 @@
+#pragma once
+#include <stdint.h>
+
+// =================================================================================
+// 定点二维值噪声
+// =================================================================================
+//
+// 坐标为 Q8 (高 8 位为格点，低 8 位为格内位置)，输出 0-255。
+// 格点值由编译期生成的 256 项置换表散列得到，格内用 smoothstep 权重双线性插值，
+// 全程 8/16 位整数运算。坐标按 uint16_t 自然回绕，时间轴可以一直累加。
+//
+// 圆柱环绕：xMask 为 x 方向格点周期减一 (周期须为 2 的幂)，
+// 例如把一周映射为 4 个格点并传入 xMask=3，则 x 方向首尾无缝衔接。
+
+namespace noise_detail {
+
+struct Perm {
+    uint8_t v[256];
+};
+
+// 固定种子的 Fisher-Yates 洗牌 (LCG)，每次编译结果一致
+constexpr Perm makePerm() {
+    Perm p{};
+    for (int i = 0; i < 256; i++) p.v[i] = (uint8_t)i;
+    uint32_t seed = 0x2545F491u;
+    for (int i = 255; i > 0; i--) {
+        seed = seed * 1664525u + 1013904223u;
+        int j = (int)((seed >> 16) % (uint32_t)(i + 1));
+        uint8_t t = p.v[i];
+        p.v[i] = p.v[j];
+        p.v[j] = t;
+    }
+    return p;
+}
+
+inline constexpr Perm kPerm = makePerm();
+
+inline uint8_t hash2(uint8_t ix, uint8_t iy) {
+    return kPerm.v[(uint8_t)(kPerm.v[ix] + iy)];
+}
+
+// smoothstep 权重 3t^2 - 2t^3 (Q8)
+inline uint8_t ease8(uint8_t t) {
+    return (uint8_t)(((uint32_t)t * t * (768u - 2u * t)) >> 16);
+}
+
+inline uint8_t lerp8(uint8_t a, uint8_t b, uint8_t t) {
+    return (uint8_t)(a + (((int)b - (int)a) * t >> 8));
+}
+
+} // namespace noise_detail
+
+/**
+ * @brief 二维值噪声
+ * @param x Q8 坐标
+ * @param y Q8 坐标
+ * @param xMask x 方向格点周期 - 1 (2 的幂减一)，0xFF 表示不额外环绕
+ * @return 0-255
+ */
+inline uint8_t noise2d(uint16_t x, uint16_t y, uint8_t xMask = 0xFF) {
+    using namespace noise_detail;
+    const uint8_t ix0 = (uint8_t)(x >> 8) & xMask;
+    const uint8_t ix1 = (uint8_t)(ix0 + 1) & xMask;
+    const uint8_t iy0 = (uint8_t)(y >> 8);
+    const uint8_t iy1 = (uint8_t)(iy0 + 1);
+    const uint8_t sx = ease8((uint8_t)x);
+    const uint8_t sy = ease8((uint8_t)y);
+
+    const uint8_t a = lerp8(hash2(ix0, iy0), hash2(ix1, iy0), sx);
+    const uint8_t b = lerp8(hash2(ix0, iy1), hash2(ix1, iy1), sx);
+    return lerp8(a, b, sy);
+}
+
+/**
+ * @brief 两个八度叠加的分形噪声 (2/3 基频 + 1/3 倍频)，细节更丰富
+ *
+ * 倍频层的 x 周期随之加倍，xMask 的环绕关系保持不变。
+ */
+inline uint8_t noise2d_fbm(uint16_t x, uint16_t y, uint8_t xMask = 0xFF) {
+    const uint16_t lo = noise2d(x, y, xMask);
+    const uint16_t hi = noise2d((uint16_t)(x << 1), (uint16_t)(y << 1), (uint8_t)((xMask << 1) | 1));
+    return (uint8_t)((lo * 171 + hi * 85) >> 8);
+}
@@ -0,0 +1,107 @@
+#include "lamp_palette.hpp"
+
+// =================================================================================
+// 调色板定义 (Flash)
+// =================================================================================
+
+namespace {
+
+// 顺序与 PaletteId 一致 (自 Rainbow 起)，名称见 kPaletteNameList
+const GradientPalette kPalettes[] = {
+    {16, {
+        {0, 255, 0, 0}, {16, 212, 43, 0}, {32, 171, 85, 0}, {48, 171, 128, 0},
+        {64, 171, 170, 0}, {80, 86, 213, 0}, {96, 0, 255, 0}, {112, 0, 212, 43},
+        {128, 0, 171, 85}, {144, 0, 86, 170}, {160, 0, 0, 255}, {176, 43, 0, 212},
+        {192, 85, 0, 171}, {208, 128, 0, 128}, {224, 170, 0, 85}, {240, 213, 0, 42}}},
+    {5, {
+        {0, 0, 0, 0}, {70, 120, 0, 0}, {140, 255, 50, 0}, {200, 255, 150, 0}, {255, 255, 255, 120}}},
+    {4, {
+        {0, 30, 6, 0}, {120, 180, 60, 2}, {200, 255, 130, 20}, {255, 255, 180, 60}}},
+    {5, {
+        {0, 0, 20, 10}, {70, 0, 160, 60}, {130, 0, 220, 140}, {190, 40, 80, 200}, {255, 150, 40, 180}}},
+    {5, {
+        {0, 0, 10, 40}, {64, 0, 60, 140}, {128, 0, 150, 200}, {192, 40, 210, 220}, {255, 160, 255, 255}}},
+    {6, {
+        {0, 40, 0, 60}, {50, 140, 0, 100}, {110, 255, 30, 40}, {170, 255, 110, 0}, {220, 255, 180, 40},
+        {255, 255, 230, 120}}},
+    {5, {
+        {0, 0, 30, 0}, {80, 20, 100, 0}, {150, 60, 160, 10}, {210, 120, 200, 20}, {255, 180, 220, 60}}},
+};
+
+static_assert(sizeof(kPalettes) / sizeof(kPalettes[0]) == (size_t)PaletteId::Count - 1,
+              "kPalettes 与 PaletteId 不一致");
+
+/**
+ * @brief 渐变节点 -> 256 项表 (线性插值)
+ */
+void expand_gradient(const GradientPalette &p, CRGB* out) {
+    for (uint8_t s = 0; s < p.count; s++) {
+        const GradientStop &a = p.stops[s];
+        const bool last = (s + 1 == p.count);
+        // 最后一段：pos < 255 时循环回到第一个节点 (位置视为 256)
+        const GradientStop &b = last ? p.stops[0] : p.stops[s + 1];
+        const int end = last ? 256 : b.pos;
+        const int span = end - a.pos;
+        if (last && a.pos == 255) {
+            out[255] = CRGB(a.r, a.g, a.b);
+            break;
+        }
+        for (int i = a.pos; i < end; i++) {
+            const int t = (i - a.pos) * 256 / span;
+            out[i] = CRGB((uint8_t)(a.r + (b.r - a.r) * t / 256),
+                          (uint8_t)(a.g + (b.g - a.g) * t / 256),
+                          (uint8_t)(a.b + (b.b - a.b) * t / 256));
+        }
+    }
+}
+
+} // namespace
+
+const GradientPalette* palette_info(PaletteId id) {
+    if (id == PaletteId::Solid || id >= PaletteId::Count) return nullptr;
+    return &kPalettes[(uint8_t)id - 1];
+}
+
+const char* palette_name(PaletteId id) {
+    return kPaletteNames.name((uint8_t)id);
+}
+
+bool palette_from_name(const char* name, PaletteId &out) {
+    const uint8_t id = kPaletteNames.find(name);
+    if (id == kPaletteNames.kNotFound) return false;
+    out = (PaletteId)id;
+    return true;
+}
+
+// =================================================================================
+// 展开缓存
+// =================================================================================
+
+/**
+ * @brief 获取调色板的 256 项表，未命中时展开到较早使用的槽
+ *
+ * @param id 调色板
+ * @param base 当前基色 (仅 Solid 使用)
+ */
+const CRGB* PaletteCache::get(PaletteId id, const CRGB &base) {
+    if (id >= PaletteId::Count) id = PaletteId::Solid;
+    for (uint8_t s = 0; s < 2; s++) {
+        if (m_id[s] == id && (id != PaletteId::Solid || m_base[s] == base)) return m_lut[s];
+    }
+
+    const uint8_t slot = m_next;
+    m_next ^= 1;
+    CRGB* lut = m_lut[slot];
+
+    if (id == PaletteId::Solid) {
+        for (int i = 0; i < 256; i++) {
+            lut[i] = CRGB(scale8(base.r, i), scale8(base.g, i), scale8(base.b, i));
+        }
+        lut[255] = base;
+    } else {
+        expand_gradient(*palette_info(id), lut);
+    }
+    m_id[slot] = id;
+    m_base[slot] = base;
+    return lut;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <Arduino.h>
+#include <FastLED.h>
+#include "lamp_names.hpp"
+
+// =================================================================================
+// 渐变调色板
+// =================================================================================
+//
+// 每个调色板最多 16 个渐变节点 (每节点 4 字节)，以 const 数据放在 Flash。
+// 特效使用前由 PaletteCache 展开成 256 项 CRGB 表，热循环中取色只是一次下标访问。
+
+// 调色板编号 (值会持久化，只能在末尾追加)
+enum class PaletteId : uint8_t {
+    Solid = 0,   // 当前 CCT/RGB 基色：黑 -> 基色 的亮度渐变
+    Rainbow,     // 色轮 (与 FastLED HSV rainbow 一致)
+    Fire,
+    Candle,
+    Aurora,
+    Ocean,
+    Sunset,
+    Forest,
+    Count
+};
+
+// 调色板名 (小写，顺序与 PaletteId 一致)：MQTT / BLE / HA 下拉选项共用
+inline constexpr const char* kPaletteNameList[(uint8_t)PaletteId::Count] = {
+    "solid", "rainbow", "fire", "candle", "aurora", "ocean", "sunset", "forest"
+};
+inline constexpr NameTable<(uint8_t)PaletteId::Count, 16> kPaletteNames{kPaletteNameList};
+static_assert(kPaletteNames.valid(), "调色板名表未找到无冲突的哈希种子");
+
+struct GradientStop {
+    uint8_t pos; // 0-255；最后一个节点小于 255 时循环插值回第一个节点
+    uint8_t r, g, b;
+};
+
+struct GradientPalette {
+    uint8_t count;
+    GradientStop stops[16];
+};
+
+const GradientPalette* palette_info(PaletteId id);            // Solid 返回 nullptr
+const char* palette_name(PaletteId id);                      // 小写名称，如 "fire"
+bool palette_from_name(const char* name, PaletteId &out);    // 不区分大小写
+
+/**
+ * @brief 256 项调色板缓存
+ *
+ * 仅展开当前使用的调色板；两槽足够覆盖交叉淡化或叠加层同时使用两个调色板的情况，
+ * 不会每帧来回重建。Solid 随基色变化，基色改变时重新展开。
+ */
+class PaletteCache {
+public:
+    const CRGB* get(PaletteId id, const CRGB &base);
+
+private:
+    CRGB m_lut[2][256];
+    PaletteId m_id[2] = {PaletteId::Count, PaletteId::Count}; // Count = 槽位无效
+    CRGB m_base[2];
+    uint8_t m_next = 0;
+};
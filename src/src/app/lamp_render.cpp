@@ -1,139 +1,298 @@
 #include "lamp.hpp"
 #include <FastLED.h>
+#include <string.h>
 
-// Gamma 2.2 校正表 (0-100) -> (0-255)
-// 重新生成以提供更好的低亮度分辨率
-const uint8_t LampController::GAMMA_TABLE[101] = {
-    0, 0, 1, 1, 2, 3, 4, 5, 6, 8, 9, 11, 13, 15, 17, 19, 21, 24, 26, 29,
-    32, 35, 38, 41, 44, 48, 51, 55, 59, 63, 67, 71, 75, 80, 84, 89, 94, 99, 104, 109,
-    114, 119, 125, 130, 136, 142, 148, 154, 160, 166, 172, 179, 185, 192, 199, 206, 213, 220, 227, 234,
-    242, 249, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
-};
-// 注意：上面的表只填充到了 62 (255)。因为 0-100 映射到 0-255，实际上 100 对应 255。
-// 让我们用更精确的计算替换查表，或者使用正确的表。
-// 既然用户抱怨低亮度问题，我们直接在 scaleChannel 中使用浮点计算或者高精度整数计算，
-// 废弃 GAMMA_TABLE 的查表方式，或者仅将其作为参考。
-// 为了保持兼容性，我们更新 scaleChannel 函数，不再依赖 GAMMA_TABLE 的 0-100 映射，
-// 而是直接计算。
+// =================================================================================
+// 亮度映射查表
+// =================================================================================
+
+namespace {
 
 /**
- * @brief 缩放通道值
- * 
- * 结合 Gamma 校正和全局亮度，计算最终的 PWM 输出值。
- * 
- * @param value 原始通道值 (0-255)
- * @param brightness 全局亮度 (0-100)
- * @return uint8_t 缩放后的值 (0-255)
+ * @brief 逻辑亮度 (0-100) -> 目标物理 PWM (0-255)
+ *
+ * 1-10%：线性映射到 kMinPwmOutput 之上 10% 的物理范围；
+ * 11-100%：Gamma 2.0 曲线映射到 kMaxPwmOutput。编译期求值生成查表。
+ * (原实现按 89^2 归一化而输入为 1..90，100% 会超出 kMaxPwmOutput，这里改为 90^2)
  */
-uint8_t LampController::scaleChannel(uint16_t value, uint8_t brightness) const {
+constexpr uint8_t targetPwmFor(uint8_t brightness) {
+    constexpr uint32_t kMin = LAMP_PWM_HARD_MIN;
+    constexpr uint32_t kMax = LAMP_PWM_HARD_MAX;
+    constexpr uint32_t range = kMax - kMin;
+    constexpr uint32_t lowEnd = kMin + range / 10;
+
     if (brightness == 0) return 0;
-    if (value == 0) return 0;
-
-    // 1. 计算目标物理亮度 (0-255 范围)
-    // 将 0-100 的逻辑亮度映射到 kMinPwmOutput - kMaxPwmOutput 的物理 PWM 范围
-    // 使用 Gamma 2.0 曲线使亮度变化更自然
-    
-    uint32_t target_pwm;
-    
     if (brightness <= 10) {
-        // 低亮度区间 (1-10%)：线性映射到 kMinPwmOutput 的低端部分
-        // 假设 kMinPwmOutput 是物理上能点亮的最小值
-        // 我们让 1% 对应 kMinPwmOutput，10% 对应一个稍亮的值
-        // 为了平滑，我们定义 low_range_max 为 kMinPwmOutput + (kMax - kMin) * 0.05
-        
-        uint32_t range = kMaxPwmOutput - kMinPwmOutput;
-        uint32_t low_end = kMinPwmOutput;
-        uint32_t high_end = kMinPwmOutput + range / 10; // 10% 的物理范围
-        
-        target_pwm = map(brightness, 1, 10, low_end, high_end);
-    } else {
-        // 高亮度区间 (>10%)：Gamma 2.0 映射
-        // 输入 11-100 -> 输出 high_end -> kMaxPwmOutput
-        
-        uint32_t range = kMaxPwmOutput - kMinPwmOutput;
-        uint32_t low_end = kMinPwmOutput + range / 10;
-        
-        // 归一化输入 0-89 (对应 11-100)
-        uint32_t b_norm = brightness - 10;
-        uint32_t b_sq = b_norm * b_norm; // Max 89*89 = 7921
-        
-        // 映射 b_sq (0-7921) 到 (low_end -> kMaxPwmOutput)
-        uint32_t pwm_range = kMaxPwmOutput - low_end;
-        target_pwm = low_end + (b_sq * pwm_range) / 7921;
+        return (uint8_t)(kMin + (brightness - 1) * (lowEnd - kMin) / 9);
     }
+    uint32_t b_norm = brightness - 10;
+    return (uint8_t)(lowEnd + (b_norm * b_norm * (kMax - lowEnd)) / 8100); // 90^2 = 8100
+}
 
-    // 2. 应用通道颜色值 (value: 0-255)
-    // 最终输出 = value * target_pwm / 255
-    uint32_t numerator = (uint32_t)value * target_pwm;
-    return (uint8_t)(numerator / 255);
+struct PwmTable {
+    uint8_t v[101];
+};
+
+constexpr PwmTable makePwmTable() {
+    PwmTable t{};
+    for (uint8_t i = 0; i <= 100; i++) t.v[i] = targetPwmFor(i);
+    return t;
 }
 
+constexpr PwmTable kPwmTable = makePwmTable();
+
+static_assert(kPwmTable.v[1] == LAMP_PWM_HARD_MIN, "1% 应对应最小物理 PWM");
+static_assert(kPwmTable.v[100] == LAMP_PWM_HARD_MAX, "100% 应对应最大物理 PWM");
+
+} // namespace
+
 /**
- * @brief 更新 LED 显示
- * 
- * 当没有特效运行时，根据当前颜色和亮度更新 LED。
+ * @brief 获取物理 PWM 对应的通道缩放表
+ *
+ * lut[v] = v * pwm / 255。两槽缓存：静态亮度只占一槽，抖动在 pwm 与 pwm+1
+ * 之间切换时两槽都命中。重建时以累加代替除法
+ * (x/255 == (x + 1 + (x >> 8)) >> 8, x <= 65025)。
+ *
+ * @param pwm 物理 PWM (0-255)
+ * @return const uint8_t* 256 项缩放表
  */
-void LampController::update() {
-    if (m_effect != EffectMode::None) return;
-
-    uint8_t r = 0, g = 0, b = 0;
-    if (m_useCCT) {
-        cctToRGB(m_cct, m_brightness, r, g, b);
-    } else {
-        r = scaleChannel(m_rgbColor.r, m_brightness);
-        g = scaleChannel(m_rgbColor.g, m_brightness);
-        b = scaleChannel(m_rgbColor.b, m_brightness);
+const uint8_t* LampController::channelScaleLut(uint8_t pwm) {
+    if (m_scaleLutPwm[0] == pwm) return m_scaleLut[0];
+    if (m_scaleLutPwm[1] == pwm) return m_scaleLut[1];
+
+    const uint8_t slot = m_scaleLutNext;
+    m_scaleLutNext ^= 1;
+
+    uint8_t* lut = m_scaleLut[slot];
+    uint32_t acc = 0;
+    for (int v = 0; v < 256; v++) {
+        lut[v] = (uint8_t)((acc + 1 + (acc >> 8)) >> 8);
+        acc += pwm;
     }
-    fill_solid(m_leds, LAMP_NUM_LEDS, CRGB(r, g, b));
+    m_scaleLutPwm[slot] = pwm;
+    return lut;
+}
+
+/**
+ * @brief 设置 Q16 逻辑亮度 (0 .. 100<<16)
+ */
+void LampController::setBrightnessQ16(uint32_t q16) {
+    if (q16 > (100u << 16)) q16 = 100u << 16;
+    m_brightnessQ16 = q16;
+    m_brightness = (uint8_t)((q16 + 0x8000) >> 16);
+}
+
+/**
+ * @brief Q16 亮度在相邻两个整数亮度的 PWM 之间线性插值 (Q8 PWM)
+ */
+static inline uint32_t pwm_q8(uint32_t q16) {
+    const uint32_t idx = q16 >> 16;
+    if (idx >= 100) return (uint32_t)kPwmTable.v[100] << 8;
+
+    const uint32_t frac = (q16 >> 8) & 0xFF;
+    const uint32_t lo = kPwmTable.v[idx];
+    const uint32_t hi = kPwmTable.v[idx + 1];
+    return (lo << 8) + (hi - lo) * frac;
+}
+
+/**
+ * @brief 计算本帧输出的物理 PWM
+ *
+ * 在相邻两个整数亮度的 PWM 之间按小数部分线性插值得到 Q8 PWM，
+ * 再用一阶 sigma-delta 把小数部分分摊到连续帧上：100Hz 帧率下
+ * 低亮度渐变获得 1/256 PWM 级的等效分辨率。
+ * 整数亮度时小数为 0，输出与查表一致，静止时无抖动。
+ */
+uint8_t LampController::ditheredPwm(uint32_t q16, uint8_t &acc) {
+    // 慢速渐变休眠期间每次输出要保持到下一次唤醒，逐帧抖动无从谈起
+    if (m_tweenSleep) return roundedPwm(q16);
+
+    const uint32_t pwmQ8 = pwm_q8(q16);
+    uint8_t pwm = (uint8_t)(pwmQ8 >> 8);
+    const uint32_t sum = (uint32_t)acc + (pwmQ8 & 0xFF);
+    if (sum >= 256) pwm++;
+    acc = (uint8_t)sum;
+    return pwm;
+}
+
+uint8_t LampController::roundedPwm(uint32_t q16) {
+    const uint32_t pwm = (pwm_q8(q16) + 0x80) >> 8;
+    return (uint8_t)(pwm > 255 ? 255 : pwm);
+}
+
+/**
+ * @brief 对整条灯带逐通道查表缩放
+ *
+ * @param lut channelScaleLut() 返回的缩放表
+ * @param src 满亮度像素
+ * @param dst 输出 (可与 src 相同)
+ */
+void LampController::applyScaleLut(const uint8_t* lut, const CRGB* src, CRGB* dst) {
+    for (int i = 0; i < LAMP_NUM_LEDS; i++) {
+        dst[i].r = lut[src[i].r];
+        dst[i].g = lut[src[i].g];
+        dst[i].b = lut[src[i].b];
+    }
+}
+
+/**
+ * @brief v * pwm / 255 (与 channelScaleLut() 的表项完全一致)
+ */
+static inline uint8_t scale_pwm(uint8_t v, uint32_t pwm) {
+    const uint32_t x = v * pwm;
+    return (uint8_t)((x + 1 + (x >> 8)) >> 8);
+}
+
+/**
+ * @brief 把满亮度合成结果缩放到输出亮度
+ *
+ * 分区均为默认状态时整条灯带共用一张缩放表；否则按分区逐块缩放：
+ * 每个分区的 PWM 只算一次，逐像素做与缩放表相同的整数除法近似
+ * (v * pwm / 255)，仍是单次遍历，开销与分区数无关。
+ */
+void LampController::scaleOutput(const CRGB* src, CRGB* dst) {
+    if (m_zonesUniform) {
+        applyScaleLut(channelScaleLut(ditheredPwm(m_brightnessQ16, m_ditherAcc)), src, dst);
+        return;
+    }
+
+    for (Zone &z : m_zones) {
+        const uint32_t pwm = ditheredPwm(zoneBrightnessQ16(z), z.ditherAcc);
+        for (uint16_t i = 0; i < LAMP_ZONE_LEDS; i++, src++, dst++) {
+            dst->r = scale_pwm(src->r, pwm);
+            dst->g = scale_pwm(src->g, pwm);
+            dst->b = scale_pwm(src->b, pwm);
+        }
+    }
+}
+
+/**
+ * @brief 提交当前帧 (持锁调用)
+ *
+ * 把后缓冲 m_leds 拷贝到前缓冲并标记待输出，实际 show() 由 flushFrame()
+ * 在释放 m_mutex 后执行。像素与上次提交完全相同时跳过：WS2812 每次
+ * show() 需约 2ms 位时序输出且会干扰中断，而比较 192 字节只需数百纳秒。
+ */
+void LampController::presentFrame() {
+    if (memcmp(m_leds, m_frontLeds, sizeof(m_leds)) == 0) {
+        m_framesSkipped++;
+        return;
+    }
+    memcpy(m_frontLeds, m_leds, sizeof(m_leds));
+    m_framePending = true;
+}
+
+/**
+ * @brief 输出前缓冲 (LampTask，不持锁)
+ *
+ * 前缓冲只由 LampTask 写入，show() 期间不会被改动。
+ */
+void LampController::flushFrame() {
+    if (!m_framePending) return;
+    m_framePending = false;
     FastLED.show();
+    m_framesShown++;
+
+    // 实时流：收包到线上输出完成的延迟
+    if (m_frontRxUs != 0) {
+        const uint32_t us = micros() - m_frontRxUs;
+        m_frontRxUs = 0;
+        m_streamStats.frames++;
+        m_streamStats.totalUs += us;
+        if (us > m_streamStats.maxUs) m_streamStats.maxUs = us;
+    }
 }
 
 /**
- * @brief CCT 转原始 RGB
- * 
- * 将色温值转换为 RGB 值，不考虑亮度。
+ * @brief 获取帧输出统计
+ */
+void LampController::getFrameStats(uint32_t &shown, uint32_t &skipped) const {
+    shown = m_framesShown;
+    skipped = m_framesSkipped;
+}
+
+void LampController::recordLockHold(uint32_t us) {
+    m_lockStats.count++;
+    m_lockStats.totalUs += us;
+    if (us > m_lockStats.maxUs) m_lockStats.maxUs = us;
+}
+
+/**
+ * @brief 获取 m_mutex 持有时长统计
+ */
+void LampController::getLockStats(LampLockStats &out) const {
+    out = m_lockStats;
+}
+
+void LampController::resetLockStats() {
+    m_lockStats = LampLockStats{};
+}
+
+/**
+ * @brief 更新 LED 显示
  * 
- * @param cct 色温 (2700-6500)
- * @param r 输出 R
- * @param g 输出 G
- * @param b 输出 B
+ * 当没有特效、叠加层或交叉淡化时，根据当前颜色和亮度更新 LED；
+ * 否则由 LampTask 每帧经 runEffect() 合成。实时流占用后缓冲期间不绘制。
  */
-void LampController::cctToRawRGB(uint16_t cct, uint8_t &r, uint8_t &g, uint8_t &b) {
-    if (cct < LAMP_CCT_MIN) cct = LAMP_CCT_MIN;
-    if (cct > LAMP_CCT_MAX) cct = LAMP_CCT_MAX;
+void LampController::update() {
+    if (isCompositing() || m_streamActive) return;
 
-    const uint8_t warmR = 255, warmG = 147, warmB = 41;
-    const uint8_t coolR = 255, coolG = 255, coolB = 255;
+    if (!m_zonesUniform) {
+        renderZones();
+        presentFrame();
+        return;
+    }
 
-    uint32_t span = LAMP_CCT_MAX - LAMP_CCT_MIN;
-    uint32_t pos = cct - LAMP_CCT_MIN;
-    uint32_t alphaQ10 = (span == 0) ? 0 : (pos * 1024u) / span;
+    const CRGB c = baseColor();
+    const uint8_t* lut = channelScaleLut(ditheredPwm(m_brightnessQ16, m_ditherAcc));
+    fill_solid(m_leds, LAMP_NUM_LEDS, CRGB(lut[c.r], lut[c.g], lut[c.b]));
+    presentFrame();
+}
 
-    auto lerpQ10 = [&](uint8_t a, uint8_t b) -> uint16_t {
-        return (uint16_t)((a * (1024u - alphaQ10) + b * alphaQ10) / 1024u);
-    };
+/**
+ * @brief 静态模式下按分区整块填色 (跟随整灯的分区使用 baseColor())
+ */
+void LampController::renderZones() {
+    const CRGB base = baseColor();
+    CRGB* px = m_leds;
+    for (Zone &z : m_zones) {
+        const CRGB &c = z.follow ? base : z.color;
+        const uint32_t pwm = ditheredPwm(zoneBrightnessQ16(z), z.ditherAcc);
+        fill_solid(px, LAMP_ZONE_LEDS, CRGB(scale_pwm(c.r, pwm), scale_pwm(c.g, pwm), scale_pwm(c.b, pwm)));
+        px += LAMP_ZONE_LEDS;
+    }
+}
 
-    r = (uint8_t)lerpQ10(warmR, coolR);
-    g = (uint8_t)lerpQ10(warmG, coolG);
-    b = (uint8_t)lerpQ10(warmB, coolB);
+/**
+ * @brief 当前模式下的基色 (CCT 或 RGB)，未做亮度缩放
+ */
+CRGB LampController::baseColor() {
+    if (!m_useCCT) return m_rgbColor;
+    uint8_t r, g, b;
+    cctToRawRGB(m_cct, r, g, b);
+    return CRGB(r, g, b);
 }
 
 /**
- * @brief CCT 转最终 RGB
+ * @brief CCT 转原始 RGB
  * 
- * 将色温值转换为 RGB 值，并应用亮度缩放。
+ * 将色温值转换为 RGB 值，不考虑亮度。查普朗克轨迹表并应用校准矩阵 (lamp_cct.hpp)，
+ * 结果按色温缓存：静止或特效运行时每帧只是一次比较；色温渐变中每帧重算一次。
  * 
- * @param cct 色温
- * @param brightness 亮度
+ * @param cct 色温 (2700-6500)
  * @param r 输出 R
  * @param g 输出 G
  * @param b 输出 B
  */
-void LampController::cctToRGB(uint16_t cct, uint8_t brightness, uint8_t &r, uint8_t &g, uint8_t &b) {
-    uint8_t rawR, rawG, rawB;
-    cctToRawRGB(cct, rawR, rawG, rawB);
-    r = scaleChannel(rawR, brightness);
-    g = scaleChannel(rawG, brightness);
-    b = scaleChannel(rawB, brightness);
+void LampController::cctToRawRGB(uint16_t cct, uint8_t &r, uint8_t &g, uint8_t &b) {
+    if (cct < LAMP_CCT_MIN) cct = LAMP_CCT_MIN;
+    if (cct > LAMP_CCT_MAX) cct = LAMP_CCT_MAX;
+
+    if (cct != m_cctRgbK) {
+        m_cctRgb = cct_to_rgb(cct, m_cctCal);
+        m_cctRgbK = cct;
+    }
+    r = m_cctRgb.r;
+    g = m_cctRgb.g;
+    b = m_cctRgb.b;
 }
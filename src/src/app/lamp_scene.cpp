@@ -0,0 +1,167 @@
+#include "lamp_scene.hpp"
+#include "lamp.hpp"
+#include <string.h>
+
+// =================================================================================
+// 内置场景 (Flash)
+// =================================================================================
+
+namespace {
+
+// 顺序与 kSceneNameList[1..] 一致
+constexpr SceneDef kBuiltinScenes[] = {
+    {scene_hash("Reading"), "Reading", 80, 1, 4500, 0, 0, 0, 500},
+    {scene_hash("Night"),   "Night",   5,  1, 2700, 0, 0, 0, 500},
+    {scene_hash("Cozy"),    "Cozy",    50, 1, 3000, 0, 0, 0, 500},
+    {scene_hash("Bright"),  "Bright",  100, 1, 6000, 0, 0, 0, 500},
+};
+
+constexpr uint8_t kBuiltinCount = sizeof(kBuiltinScenes) / sizeof(kBuiltinScenes[0]);
+
+static_assert(scene_hash("READING") == scene_hash("reading"), "场景哈希应不区分大小写");
+static_assert(kBuiltinCount + 1 == kSceneNames.size(), "内置场景与名称表不一致");
+
+constexpr bool builtin_names_match() {
+    for (uint8_t i = 0; i < kBuiltinCount; i++) {
+        if (kBuiltinScenes[i].hash != scene_hash(kSceneNames.name(i + 1))) return false;
+    }
+    return true;
+}
+static_assert(builtin_names_match(), "内置场景顺序与名称表不一致");
+
+bool name_matches(const SceneDef &def, uint32_t hash, const char* name) {
+    return def.hash == hash && strcasecmp(def.name, name) == 0;
+}
+
+} // namespace
+
+uint8_t SceneRegistry::builtinCount() {
+    return kBuiltinCount;
+}
+
+const SceneDef &SceneRegistry::builtin(uint8_t i) {
+    return kBuiltinScenes[i < kBuiltinCount ? i : 0];
+}
+
+// =================================================================================
+// 查找与修改 (仅 LampTask 调用)
+// =================================================================================
+
+SceneSlot SceneRegistry::lookup(const char* name) const {
+    if (name == nullptr) return kSceneNone;
+    if (m_userCount > 0) {
+        const uint32_t hash = scene_hash(name);
+        for (uint8_t i = 0; i < m_userCount; i++) {
+            if (name_matches(m_user[i], hash, name)) return kSceneUserBase + i;
+        }
+    }
+    const uint8_t id = kSceneNames.find(name);
+    return id == kSceneNames.kNotFound ? kSceneNone : id;
+}
+
+const SceneDef* SceneRegistry::at(SceneSlot slot) const {
+    if (slot >= kSceneUserBase) {
+        const uint8_t i = slot - kSceneUserBase;
+        return i < m_userCount ? &m_user[i] : nullptr;
+    }
+    if (slot == kSceneNone || slot > kBuiltinCount) return nullptr;
+    return &kBuiltinScenes[slot - 1];
+}
+
+const char* SceneRegistry::name(SceneSlot slot) const {
+    const SceneDef* def = at(slot);
+    return def ? def->name : kSceneNames.name(kSceneNone);
+}
+
+bool SceneRegistry::store(const SceneDef &def) {
+    if (def.name[0] == '\0' || strcasecmp(def.name, "none") == 0) return false;
+
+    SceneDef copy = def;
+    copy.name[sizeof(copy.name) - 1] = '\0';
+    copy.hash = scene_hash(copy.name);
+
+    for (uint8_t i = 0; i < m_userCount; i++) {
+        if (name_matches(m_user[i], copy.hash, copy.name)) {
+            m_user[i] = copy;
+            return true;
+        }
+    }
+    if (m_userCount >= kMaxUserScenes) return false;
+    m_user[m_userCount++] = copy;
+    return true;
+}
+
+bool SceneRegistry::remove(const char* name, SceneSlot &active) {
+    const SceneSlot slot = lookup(name);
+    if (slot < kSceneUserBase) return false;
+
+    const uint8_t i = slot - kSceneUserBase;
+    memmove(&m_user[i], &m_user[i + 1], (m_userCount - i - 1) * sizeof(SceneDef));
+    m_userCount--;
+
+    if (active == slot) active = kSceneNone;
+    else if (active > slot) active--;
+    return true;
+}
+
+/**
+ * @brief 载入 NVS 中的用户场景，名称为空或哈希不符的条目丢弃
+ */
+void SceneRegistry::loadUser(const SceneDef* defs, uint8_t count) {
+    m_userCount = 0;
+    for (uint8_t i = 0; i < count && m_userCount < kMaxUserScenes; i++) {
+        SceneDef def = defs[i];
+        def.name[sizeof(def.name) - 1] = '\0';
+        if (def.name[0] == '\0' || def.hash != scene_hash(def.name)) continue;
+        m_user[m_userCount++] = def;
+    }
+}
+
+// =================================================================================
+// 文本解析 (MQTT / BLE 共用)
+// =================================================================================
+
+bool scene_parse(const char* spec, SceneDef &def) {
+    if (spec == nullptr) return false;
+
+    char buf[96];
+    strncpy(buf, spec, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    char* save = nullptr;
+    char* tok = strtok_r(buf, ",", &save);
+    if (tok == nullptr || strchr(tok, '=') != nullptr) return false;
+    if (strlen(tok) >= sizeof(def.name)) return false;
+    strncpy(def.name, tok, sizeof(def.name) - 1);
+    def.name[sizeof(def.name) - 1] = '\0';
+
+    while ((tok = strtok_r(nullptr, ",", &save)) != nullptr) {
+        char* eq = strchr(tok, '=');
+        if (eq == nullptr) return false;
+        *eq = '\0';
+        const char* key = tok;
+        const char* val = eq + 1;
+
+        uint32_t v = 0;
+
+        if (strcmp(key, "bri") == 0) {
+            if (!LampController::parseUint(val, 1, 100, v)) return false;
+            def.brightness = (uint8_t)v;
+        } else if (strcmp(key, "cct") == 0) {
+            if (!LampController::parseUint(val, 1000, 20000, v)) return false;
+            def.cctMode = 1;
+            def.cct = (uint16_t)v; // 应用时再钳位到 LAMP_CCT_MIN/MAX
+        } else if (strcmp(key, "rgb") == 0) {
+            if (!LampController::parseRgb(val, def.r, def.g, def.b)) return false;
+            def.cctMode = 0;
+        } else if (strcmp(key, "fade") == 0) {
+            if (!LampController::parseUint(val, 0, 60000, v)) return false;
+            def.fadeMs = (uint16_t)v;
+        } else {
+            return false;
+        }
+    }
+
+    def.hash = scene_hash(def.name);
+    return true;
+}
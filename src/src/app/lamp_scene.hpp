@@ -0,0 +1,76 @@
+#pragma once
+#include <Arduino.h>
+#include "lamp_names.hpp"
+
+// =================================================================================
+// 场景注册表
+// =================================================================================
+//
+// 内置场景为 Flash 中的 constexpr 表，用户场景 (最多 kMaxUserScenes 个) 整块存 NVS。
+// 内置场景名走编译期完美哈希表；用户场景以保存时算好的 32 位哈希为键。
+// 命中后再核对一次名称防止哈希碰撞。同名用户场景覆盖内置场景。
+//
+// 当前场景以 SceneSlot (1 字节) 表示，名称只在发布状态时按槽位取出。
+
+/**
+ * @brief 场景名哈希 (标准 FNV-1a，ASCII 不区分大小写；值随用户场景持久化)
+ */
+constexpr uint32_t scene_hash(const char* s) {
+    return name_hash(s);
+}
+
+// 内置场景名，序号即 SceneSlot (0 = 无场景)
+inline constexpr const char* kSceneNameList[] = {"None", "Reading", "Night", "Cozy", "Bright"};
+inline constexpr NameTable<sizeof(kSceneNameList) / sizeof(kSceneNameList[0]), 8> kSceneNames{kSceneNameList};
+static_assert(kSceneNames.valid(), "场景名表未找到无冲突的哈希种子");
+
+// 场景槽位：0 = 无，1.. = 内置场景，kSceneUserBase + i = 第 i 个用户场景
+using SceneSlot = uint8_t;
+static constexpr SceneSlot kSceneNone = 0;
+static constexpr SceneSlot kSceneUserBase = 0x80;
+
+// 场景定义 (值会持久化，只能在末尾追加字段)
+struct SceneDef {
+    uint32_t hash;        // scene_hash(name)
+    char name[12];        // 显示名，最多 11 字符 (与 LampCommand::scene 一致)
+    uint8_t brightness;   // 用户亮度 1-100
+    uint8_t cctMode;      // 1 = 色温，0 = RGB
+    uint16_t cct;         // 色温 K (cctMode = 1)
+    uint8_t r, g, b;      // RGB (cctMode = 0)
+    uint16_t fadeMs;      // 亮度与颜色共用的渐变时长
+};
+
+class SceneRegistry {
+public:
+    static constexpr uint8_t kMaxUserScenes = 8;
+
+    SceneSlot lookup(const char* name) const;       // 用户场景优先；未找到或 "None" 返回 kSceneNone
+    const SceneDef* at(SceneSlot slot) const;       // kSceneNone / 无效槽位返回 nullptr
+    const SceneDef* find(const char* name) const { return at(lookup(name)); }
+    const char* name(SceneSlot slot) const;         // 无效槽位返回 "None"
+    bool store(const SceneDef &def);                // 同名替换，否则追加；已满返回 false
+    // 只能删除用户场景；active 为当前场景槽位，被删除时置为 kSceneNone，其后的用户槽位前移
+    bool remove(const char* name, SceneSlot &active);
+
+    // 持久化：用户场景数组整块读写
+    const SceneDef* userScenes() const { return m_user; }
+    uint8_t userCount() const { return m_userCount; }
+    void loadUser(const SceneDef* defs, uint8_t count);
+
+    static uint8_t builtinCount();
+    static const SceneDef &builtin(uint8_t i);
+
+private:
+    SceneDef m_user[kMaxUserScenes]{};
+    uint8_t m_userCount = 0;
+};
+
+/**
+ * @brief 解析场景文本 "name[,bri=80][,cct=4500|rgb=255:120:0][,fade=800]"
+ *
+ * 未给出的字段保留 def 中原有的值 (调用方预先填入当前灯光状态，
+ * 因此只给名称即为“把当前状态保存为场景”)。
+ *
+ * @return false 表示格式错误
+ */
+bool scene_parse(const char* spec, SceneDef &def);
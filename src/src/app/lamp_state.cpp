@@ -0,0 +1,104 @@
+#include "lamp.hpp"
+#include <string.h>
+
+// =================================================================================
+// 状态快照 (seqlock)
+//
+// 唯一写者是 LampTask：写入前把 m_stateSeq 置为奇数，写完置回偶数。
+// 读者拷贝快照前后各读一次序号，两次相同且为偶数即得到一致的状态，
+// 不需要 m_mutex，也不会复制 String。
+// =================================================================================
+
+static bool same_zones(const LampStateSnapshot &a, const LampStateSnapshot &b) {
+    for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+        const LampStateSnapshot::Zone &x = a.zones[i];
+        const LampStateSnapshot::Zone &y = b.zones[i];
+        if (x.on != y.on || x.level != y.level || x.follow != y.follow || x.cctMode != y.cctMode ||
+            x.cct != y.cct || x.rgb != y.rgb) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool same_state(const LampStateSnapshot &a, const LampStateSnapshot &b) {
+    return a.on == b.on &&
+           a.brightness == b.brightness &&
+           a.savedBrightness == b.savedBrightness &&
+           a.cctMode == b.cctMode &&
+           a.cct == b.cct &&
+           a.rgb == b.rgb &&
+           a.effect == b.effect &&
+           memcmp(&a.params, &b.params, sizeof(a.params)) == 0 &&
+           a.autoBrightness == b.autoBrightness &&
+           strcmp(a.scene, b.scene) == 0 &&
+           a.live == b.live &&
+           same_zones(a, b);
+}
+
+/**
+ * @brief 采集当前状态并在有变化时发布新快照
+ *
+ * 在 LampTask 每帧末尾 (持有 m_mutex) 调用；状态未变化时不改动序号。
+ */
+void LampController::publishState() {
+    LampStateSnapshot next{};
+    next.on = m_on;
+    next.brightness = m_brightness;
+    next.savedBrightness = getSavedBrightness();
+    next.cctMode = m_useCCT;
+    next.cct = getCCT();
+    next.rgb = getRGB();
+    next.effect = m_effect;
+    next.params = m_effectParams[(uint8_t)m_effect];
+    next.autoBrightness = m_autoBrightness;
+    strncpy(next.scene, m_scenes.name(m_scene), sizeof(next.scene) - 1);
+    next.live = m_streamActive;
+    for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+        const Zone &z = m_zones[i];
+        LampStateSnapshot::Zone &out = next.zones[i];
+        out.on = z.on;
+        out.level = z.level;
+        out.follow = z.follow || z.releasing;
+        out.cctMode = out.follow ? next.cctMode : z.cctMode;
+        out.cct = out.follow ? next.cct : z.cct;
+        out.rgb = out.follow ? next.rgb : z.target;
+    }
+
+    uint32_t seq = m_stateSeq.load(std::memory_order_relaxed);
+    if (seq != 0 && same_state(next, m_snapshot)) return;
+
+    next.version = seq / 2 + 1;
+
+    m_stateSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_snapshot = next;
+    m_stateSeq.store(seq + 2, std::memory_order_release);
+}
+
+/**
+ * @brief 读取一致的状态快照
+ *
+ * 若读到写入中的序号则让出 1 tick：读者 (如 GUI) 优先级可能高于 LampTask，
+ * 单核上原地自旋会让写者永远无法完成。
+ *
+ * @return 快照版本 (0 表示尚未发布)
+ */
+uint32_t LampController::getState(LampStateSnapshot &out) const {
+    for (;;) {
+        uint32_t before = m_stateSeq.load(std::memory_order_acquire);
+        if (before & 1) {
+            vTaskDelay(1);
+            continue;
+        }
+        out = m_snapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_stateSeq.load(std::memory_order_relaxed) == before) {
+            return before / 2;
+        }
+    }
+}
+
+uint32_t LampController::stateVersion() const {
+    return m_stateSeq.load(std::memory_order_acquire) / 2;
+}
@@ -13,15 +13,23 @@ void LampController::markChanged() {
     m_lastChangeMs = millis();
 }
 
+/**
+ * @brief 是否有等待延迟提交的脏数据
+ */
+bool LampController::hasPendingFlush() const {
+    if (m_lastChangeMs == 0) return false;
+    return m_dirty_on || m_dirty_br || m_dirty_cct || m_dirty_rgb || m_dirty_mode || m_dirty_auto_br || m_dirty_fx || m_dirty_cal ||
+           m_dirty_scenes || m_dirty_zones;
+}
+
 /**
  * @brief 检查并写入 NVS
  * 
  * 在 taskLoop 中调用。如果状态改变超过一定时间（COMMIT_DELAY_MS），则写入 NVS。
  */
 void LampController::flushIfIdle() {
-    if (!(m_dirty_on || m_dirty_br || m_dirty_cct || m_dirty_rgb || m_dirty_mode || m_dirty_auto_br)) return;
+    if (!hasPendingFlush()) return;
     uint32_t now = millis();
-    if (m_lastChangeMs == 0) return;
     if (now - m_lastChangeMs >= COMMIT_DELAY_MS) {
         flushNow();
     }
@@ -55,6 +63,22 @@ void LampController::flushNow() {
         saveAutoBrightnessToNVS();
         m_dirty_auto_br = false;
     }
+    if (m_dirty_fx) {
+        saveEffectParamsToNVS();
+        m_dirty_fx = false;
+    }
+    if (m_dirty_cal) {
+        saveCctCalibrationToNVS();
+        m_dirty_cal = false;
+    }
+    if (m_dirty_scenes) {
+        saveScenesToNVS();
+        m_dirty_scenes = false;
+    }
+    if (m_dirty_zones) {
+        saveZonesToNVS();
+        m_dirty_zones = false;
+    }
     m_lastChangeMs = 0;
 }
 
@@ -90,6 +114,34 @@ void LampController::loadStateFromNVS() {
     m_rgbColor = CRGB(r, g, b);
     m_useCCT = isCCT;
     m_autoBrightness = autoBr;
+
+    // 特效参数整块存储；新特效追加在末尾，旧固件保存的较短数组只覆盖前面的特效
+    EffectParams fx[EFFECT_MODE_COUNT];
+    const size_t fxCount = AppConfig::instance().loadEffectParams(fx, sizeof(fx)) / sizeof(EffectParams);
+    if (fxCount > 0) {
+        for (uint8_t i = 0; i < fxCount; i++) {
+            if (fx[i].palette >= PaletteId::Count) fx[i].palette = m_effectParams[i].palette;
+            m_effectParams[i] = fx[i];
+        }
+    }
+
+    // 白点校准矩阵 (未校准的设备为单位矩阵)
+    CctCalibration cal;
+    if (AppConfig::instance().loadCctCalibration(cal.m, sizeof(cal.m))) {
+        bool valid = true;
+        for (int16_t v : cal.m) {
+            if (v > CctCalibration::kLimit || v < -CctCalibration::kLimit) valid = false;
+        }
+        if (valid) m_cctCal = cal;
+    }
+    m_cctRgbK = 0;
+
+    // 用户场景 (整块存储，条目数由长度决定)
+    SceneDef scenes[SceneRegistry::kMaxUserScenes];
+    const size_t len = AppConfig::instance().loadScenes(scenes, sizeof(scenes));
+    m_scenes.loadUser(scenes, (uint8_t)(len / sizeof(SceneDef)));
+
+    loadZonesFromNVS();
 }
 
 void LampController::saveOnToNVS() {
@@ -118,6 +170,21 @@ void LampController::saveModeToNVS() {
     AppConfig::instance().saveMode(m_useCCT);
 }
 
+void LampController::saveEffectParamsToNVS() {
+    AppConfig::instance().begin();
+    AppConfig::instance().saveEffectParams(m_effectParams, sizeof(m_effectParams));
+}
+
+void LampController::saveCctCalibrationToNVS() {
+    AppConfig::instance().begin();
+    AppConfig::instance().saveCctCalibration(m_cctCal.m, sizeof(m_cctCal.m));
+}
+
+void LampController::saveScenesToNVS() {
+    AppConfig::instance().begin();
+    AppConfig::instance().saveScenes(m_scenes.userScenes(), m_scenes.userCount() * sizeof(SceneDef));
+}
+
 void LampController::saveAutoBrightnessToNVS() {
     AppConfig::instance().begin();
     AppConfig::instance().saveAutoBrightness(m_autoBrightness);
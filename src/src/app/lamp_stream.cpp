@@ -0,0 +1,87 @@
+#include "lamp.hpp"
+
+// =================================================================================
+// 实时像素流 (DDP / E1.31，接收端见 network/udp_stream.cpp)
+//
+// 接收任务持有 m_mutex 时把数据包的像素部分直接收进后缓冲 m_leds (不经中间缓冲)，
+// 帧完整后唤醒 LampTask。流期间 m_leds 保存未缩放的原始像素：LampTask 按整灯/分区
+// 亮度缩放后直接写入前缓冲，因此亮度渐变与开关仍然生效，部分更新也不会被重复缩放。
+// 超过 STREAM_TIMEOUT_MS 没有数据包时停止，当前特效/静态画面在同一帧恢复。
+// =================================================================================
+
+CRGB* LampController::lockStreamBuffer(TickType_t wait) {
+    if (m_mutex == nullptr || !xSemaphoreTake(m_mutex, wait)) return nullptr;
+    return m_leds;
+}
+
+void LampController::unlockStreamBuffer(uint32_t offset, uint32_t len, bool push, uint32_t rxUs) {
+    if (len == 0) {
+        xSemaphoreGive(m_mutex);
+        return;
+    }
+    if (!m_streamActive) {
+        // 新的流从黑屏开始：只清掉本包没有覆盖的像素，收包失败时后缓冲保持原样
+        const uint16_t first = (uint16_t)(offset / 3);
+        const uint16_t last = (uint16_t)((offset + len + 2) / 3);
+        fill_solid(m_leds, first, CRGB::Black);
+        if (last < LAMP_NUM_LEDS) fill_solid(m_leds + last, LAMP_NUM_LEDS - last, CRGB::Black);
+        m_streamActive = true;
+        Serial.println("[Lamp] Realtime stream started");
+    }
+    m_streamLastMs = millis();
+    if (push) {
+        m_streamPending = true;
+        m_streamRxUs = rxUs ? rxUs : 1; // 0 表示非流帧
+    }
+    xSemaphoreGive(m_mutex);
+    if (push) wake();
+}
+
+void LampController::endStream() {
+    if (m_mutex == nullptr || !xSemaphoreTake(m_mutex, portMAX_DELAY)) return;
+    if (m_streamActive) m_streamLastMs = millis() - STREAM_TIMEOUT_MS; // 下一帧按超时处理
+    xSemaphoreGive(m_mutex);
+    wake();
+}
+
+/**
+ * @brief 输出流帧或处理超时 (LampTask，持锁)
+ *
+ * @return true 表示本帧由实时流占用，不再运行特效
+ */
+bool LampController::serviceStream() {
+    if (!m_streamActive) return false;
+    if (millis() - m_streamLastMs >= STREAM_TIMEOUT_MS) {
+        stopStream();
+        return false;
+    }
+    // 新帧，或亮度渐变中需要按新亮度重新缩放
+    if (m_streamPending || m_tween.anyActive()) {
+        scaleOutput(m_leds, m_frontLeds);
+        m_framePending = true;
+        m_frontRxUs = m_streamPending ? m_streamRxUs : 0;
+        m_streamPending = false;
+    }
+    return true;
+}
+
+void LampController::stopStream() {
+    m_streamActive = false;
+    m_streamPending = false;
+    Serial.printf("[Lamp] Realtime stream stopped (%u frames, avg %u us, max %u us)\n",
+                  (unsigned)m_streamStats.frames,
+                  (unsigned)(m_streamStats.frames ? m_streamStats.totalUs / m_streamStats.frames : 0),
+                  (unsigned)m_streamStats.maxUs);
+    update(); // 静态模式重绘；特效模式由本帧的 runEffect() 覆盖
+}
+
+/**
+ * @brief 获取实时流统计 (收包到 show() 完成的延迟)
+ */
+void LampController::getStreamStats(LampStreamStats &out) const {
+    out = m_streamStats;
+}
+
+void LampController::resetStreamStats() {
+    m_streamStats = LampStreamStats{};
+}
@@ -0,0 +1,190 @@
+#include "lamp_tween.hpp"
+
+// =================================================================================
+// 多轨道渐变引擎
+// =================================================================================
+
+/**
+ * @brief 曲线映射 (输入输出均为 Q16: 0..65535)
+ *
+ * t < 2^16，因此 t*t 不超过 32 位，无需 64 位运算。
+ */
+uint32_t TweenEngine::ease(FadeCurve curve, uint32_t t) {
+    if (t == 0) return 0;
+    if (t >= 65535) return 65535;
+
+    switch (curve) {
+        case FadeCurve::Linear:
+            return t;
+        case FadeCurve::EaseIn:
+            return (t * t) >> 16;
+        case FadeCurve::EaseOut: {
+            uint32_t u = 65535u - t;
+            return 65535u - ((u * u) >> 16);
+        }
+        case FadeCurve::EaseInOut:
+        case FadeCurve::Smoothstep: {
+            uint32_t t2 = (t * t) >> 16;
+            uint32_t t3 = (t2 * t) >> 16;
+            return (3 * t2) - (2 * t3);
+        }
+        default:
+            return t;
+    }
+}
+
+TweenEngine::Track *TweenEngine::find(uint8_t key) {
+    if (key >= 32 || !(m_activeMask & (1u << key))) return nullptr;
+    for (auto &t : m_tracks) {
+        if (t.count && t.key == key) return &t;
+    }
+    return nullptr;
+}
+
+const TweenEngine::Track *TweenEngine::find(uint8_t key) const {
+    return const_cast<TweenEngine *>(this)->find(key);
+}
+
+/**
+ * @brief 取得 key 对应轨道：复用同键轨道，否则占用一条空闲轨道
+ */
+TweenEngine::Track *TweenEngine::acquire(uint8_t key) {
+    if (key >= 32) return nullptr;
+    Track *t = find(key);
+    if (t) return t;
+    for (auto &slot : m_tracks) {
+        if (slot.count == 0) return &slot;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 进入当前关键帧段：预计算每 ms 的 Q48 进度增量
+ */
+void TweenEngine::beginSegment(Track &t) {
+    const Keyframe &kf = t.frames[t.index];
+    t.remaining = kf.durationMs;
+    t.phase = 0;
+    t.rate = kf.durationMs ? (kPhaseOne - 1) / kf.durationMs : 0;
+}
+
+/**
+ * @brief 当前段再前进 dt_ms 后的值 (调用方保证 dt_ms < remaining，进度不会越过 1.0)
+ */
+int32_t TweenEngine::valueAfter(const Track &t, uint32_t dt_ms) {
+    const Keyframe &kf = t.frames[t.index];
+    const uint64_t phase = t.phase + (uint64_t)dt_ms * t.rate;
+    uint32_t e = ease(kf.curve, (uint32_t)(phase >> 32));
+    // 差值可能超过 16 位 (如色温)，乘积用 64 位乘法 (RV32 上为 mul/mulh，无除法)
+    return t.from + (int32_t)(((int64_t)(kf.value - t.from) * (int64_t)e) >> 16);
+}
+
+bool TweenEngine::start(uint8_t key, int32_t from, int32_t to, uint32_t durationMs, FadeCurve curve) {
+    Keyframe kf{to, durationMs, curve};
+    return startSequence(key, from, &kf, 1);
+}
+
+bool TweenEngine::startSequence(uint8_t key, int32_t from, const Keyframe *frames, uint8_t count) {
+    if (count == 0) return false;
+    if (count > kMaxKeyframes) count = kMaxKeyframes;
+
+    Track *t = acquire(key);
+    if (!t) return false;
+
+    t->key = key;
+    t->index = 0;
+    t->count = count;
+    t->from = from;
+    t->value = from;
+    for (uint8_t i = 0; i < count; i++) t->frames[i] = frames[i];
+    beginSegment(*t);
+
+    m_activeMask |= 1u << key;
+    return true;
+}
+
+void TweenEngine::cancel(uint8_t key) {
+    Track *t = find(key);
+    if (!t) return;
+    t->count = 0;
+    m_activeMask &= ~(1u << key);
+}
+
+void TweenEngine::cancelAll() {
+    for (auto &t : m_tracks) t.count = 0;
+    m_activeMask = 0;
+}
+
+bool TweenEngine::isActive(uint8_t key) const {
+    return key < 32 && (m_activeMask & (1u << key));
+}
+
+bool TweenEngine::value(uint8_t key, int32_t &out) const {
+    const Track *t = find(key);
+    if (!t) return false;
+    out = t->value;
+    return true;
+}
+
+bool TweenEngine::target(uint8_t key, int32_t &out) const {
+    const Track *t = find(key);
+    if (!t) return false;
+    out = t->frames[t->count - 1].value;
+    return true;
+}
+
+uint8_t TweenEngine::step(uint32_t dt_ms, Update *out) {
+    if (!m_activeMask) return 0;
+
+    uint8_t n = 0;
+    for (auto &t : m_tracks) {
+        if (t.count == 0) continue;
+        const Keyframe &kf = t.frames[t.index];
+
+        // 本段结束：落到关键帧值，进入下一段或结束轨道 (剩余的 dt 不跨段补偿)
+        if (dt_ms >= t.remaining) {
+            bool moved = t.value != kf.value;
+            t.value = kf.value;
+            t.from = kf.value;
+            if (++t.index >= t.count) {
+                t.count = 0;
+                m_activeMask &= ~(1u << t.key);
+                moved = true; // 结束时总是上报，便于调用方收尾
+            } else {
+                beginSegment(t);
+            }
+            if (moved) out[n++] = {t.key, t.value};
+            continue;
+        }
+
+        // dt < remaining，故 phase + dt*rate 不会超过 2^48
+        const int32_t v = valueAfter(t, dt_ms);
+        t.remaining -= dt_ms;
+        t.phase += (uint64_t)dt_ms * t.rate;
+        if (v != t.value) {
+            t.value = v;
+            out[n++] = {t.key, v};
+        }
+    }
+    return n;
+}
+
+uint32_t TweenEngine::nextChangeMs(uint32_t withinMs, ChangeFn changed, void *ctx) const {
+    uint32_t next = UINT32_MAX;
+    for (const auto &t : m_tracks) {
+        if (t.count == 0) continue;
+        if (t.remaining <= withinMs) return 0;
+        if (changed(ctx, t.key, t.value, valueAfter(t, withinMs))) return 0;
+
+        // 首次变化落在 (lo, hi]：lo 处未变化，hi 为段结束 (总会上报)
+        uint32_t lo = withinMs;
+        uint32_t hi = t.remaining;
+        while (hi - lo > 1) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if (changed(ctx, t.key, t.value, valueAfter(t, mid))) hi = mid;
+            else lo = mid;
+        }
+        if (hi < next) next = hi;
+    }
+    return next;
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <Arduino.h>
+
+// 渐变曲线类型
+enum class FadeCurve : uint8_t {
+	Linear,        // 线性
+	EaseIn,        // 缓入（平方）
+	EaseOut,       // 缓出（平方）
+	EaseInOut,     // 缓入缓出（余弦）
+	Smoothstep     // 更平滑的 S 曲线（smootherstep 近似）
+};
+
+// 分区轨道预留数量 (LAMP_NUM_ZONES 不得超过)
+static constexpr uint8_t TWEEN_MAX_ZONES = 4;
+
+// 渐变轨道键 (0-31)：每个属性一条轨道，互不影响
+enum TweenKey : uint8_t {
+    TWEEN_BRIGHTNESS = 0,
+    TWEEN_CCT,
+    TWEEN_COLOR,        // RGB 渐变进度 0-65536 (颜色由 ColorFade 在插值空间中计算)
+    TWEEN_CROSSFADE,    // 特效切换交叉淡化 0-255
+    TWEEN_ZONE_LEVEL,   // 分区亮度 (Q16)，每区一条：TWEEN_ZONE_LEVEL + zone
+    TWEEN_ZONE_COLOR = TWEEN_ZONE_LEVEL + TWEEN_MAX_ZONES, // 分区颜色进度 0-65536，每区一条
+    TWEEN_KEY_COUNT = TWEEN_ZONE_COLOR + TWEEN_MAX_ZONES
+};
+
+/**
+ * @brief 多轨道渐变引擎
+ *
+ * 固定容量的轨道池，每条轨道按键 (TweenKey 或调用方自定义 0-31) 区分，
+ * 可包含若干关键帧，每段有独立时长与曲线。
+ *
+ * 步进全部为定点乘加：段开始时预先计算一次 2^48 / duration，之后每帧只做乘加，
+ * 不再有逐帧 64 位除法。进度取 Q48，数小时的段结束时也不会因增量截断而明显欠步。
+ * 每条活动轨道的单帧开销恒定。
+ *
+ * 输出变化很慢时 (长渐变)，调用方可用 nextChangeMs() 求出输出下一次实际变化的时刻，
+ * 只在那时步进，而不必按帧率空转。
+ */
+class TweenEngine {
+public:
+    static constexpr uint8_t kMaxTracks = 16; // 整灯 4 条 + 每个分区 2 条
+    static constexpr uint8_t kMaxKeyframes = 4;
+
+    struct Update {
+        uint8_t key;
+        int32_t value;
+    };
+
+    struct Keyframe {
+        int32_t value;        // 段终点值
+        uint32_t durationMs;  // 段时长 (0 = 下一帧直接到达)
+        FadeCurve curve;
+    };
+
+    /**
+     * @brief 判断轨道值从 from 变为 to 时调用方的输出是否改变 (如量化到 PWM 后是否不同)
+     */
+    using ChangeFn = bool (*)(void *ctx, uint8_t key, int32_t from, int32_t to);
+
+    /**
+     * @brief 启动单段渐变 (替换同键轨道)
+     * @return false 表示轨道池已满
+     */
+    bool start(uint8_t key, int32_t from, int32_t to, uint32_t durationMs, FadeCurve curve);
+
+    /**
+     * @brief 启动关键帧序列 (替换同键轨道)，count 超过 kMaxKeyframes 时截断
+     */
+    bool startSequence(uint8_t key, int32_t from, const Keyframe *frames, uint8_t count);
+
+    void cancel(uint8_t key);
+    void cancelAll();
+
+    bool isActive(uint8_t key) const;
+    bool anyActive() const { return m_activeMask != 0; }
+
+    bool value(uint8_t key, int32_t &out) const;   // 当前值
+    bool target(uint8_t key, int32_t &out) const;  // 最终关键帧的值
+
+    /**
+     * @brief 所有活动轨道前进 dt_ms
+     * @param out 至少 kMaxTracks 项，写入本帧值发生变化 (含刚结束) 的轨道
+     * @return 写入 out 的项数
+     */
+    uint8_t step(uint32_t dt_ms, Update *out);
+
+    /**
+     * @brief 所有活动轨道中，输出下一次变化还需多少 ms
+     *
+     * 各曲线在一段内单调，先检查 withinMs 内是否已变化 (是则返回 0，调用方应逐帧推进)，
+     * 否则在当前段内二分查找首次变化的时刻。段结束时刻总会计入 (关键帧值须在该时刻落定)。
+     *
+     * @return 无活动轨道时返回 UINT32_MAX
+     */
+    uint32_t nextChangeMs(uint32_t withinMs, ChangeFn changed, void *ctx) const;
+
+    static uint32_t ease(FadeCurve curve, uint32_t t_q16);
+
+private:
+    struct Track {
+        uint8_t key;
+        uint8_t index;       // 当前关键帧
+        uint8_t count;       // 关键帧数量
+        int32_t from;        // 当前段起点
+        int32_t value;       // 当前值
+        uint32_t remaining;  // 当前段剩余 ms
+        uint64_t phase;      // 当前段进度 (Q48)
+        uint64_t rate;       // 每 ms 进度增量 (Q48)，段开始时预计算
+        Keyframe frames[kMaxKeyframes];
+    };
+    static constexpr uint64_t kPhaseOne = 1ull << 48;
+
+    Track *find(uint8_t key);
+    const Track *find(uint8_t key) const;
+    Track *acquire(uint8_t key);
+    static void beginSegment(Track &t);
+    static int32_t valueAfter(const Track &t, uint32_t dt_ms); // dt_ms < remaining 时的段内值
+
+    Track m_tracks[kMaxTracks]{};
+    uint32_t m_activeMask = 0; // bit = 1 << key
+};
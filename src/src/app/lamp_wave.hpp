@@ -0,0 +1,110 @@
+#pragma once
+#include <stdint.h>
+
+// =================================================================================
+// 定点波形发生器 (Q15)
+// =================================================================================
+//
+// ESP32-C3 无 FPU，特效热循环中不使用 float/double 与 libm。
+// 相位统一为 uint16_t，一个周期 = 65536；幅值为 Q15 (32768 = 1.0)。
+// 查找表在编译期生成 (constexpr)，以 const 数据放入 Flash，运行时仅查表与线性插值。
+
+namespace wave_detail {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// 编译期 sin：先归约到 [-pi, pi]，再用泰勒级数
+constexpr double ct_sin(double x) {
+    while (x > kPi) x -= 2 * kPi;
+    while (x < -kPi) x += 2 * kPi;
+    double term = x, sum = x;
+    for (int n = 1; n < 12; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+// 编译期 exp：仅用于 |x| <= 1
+constexpr double ct_exp(double x) {
+    double term = 1, sum = 1;
+    for (int n = 1; n < 20; n++) {
+        term *= x / n;
+        sum += term;
+    }
+    return sum;
+}
+
+// 257 项：最后一项等于第一项，插值时无需回绕判断
+struct WaveTable {
+    int16_t v[257];
+};
+
+constexpr WaveTable makeSineTable() {
+    WaveTable t{};
+    for (int i = 0; i <= 256; i++) {
+        double s = ct_sin(2 * kPi * i / 256);
+        t.v[i] = (int16_t)(s * 32767 + (s >= 0 ? 0.5 : -0.5));
+    }
+    return t;
+}
+
+// 呼吸曲线 (e^sin - e^-1) / (e - e^-1)：亮段短、暗段长，比正弦更接近人眼感受
+constexpr WaveTable makeBreathTable() {
+    WaveTable t{};
+    const double lo = ct_exp(-1), hi = ct_exp(1);
+    for (int i = 0; i <= 256; i++) {
+        double b = (ct_exp(ct_sin(2 * kPi * i / 256)) - lo) / (hi - lo);
+        t.v[i] = (int16_t)(b * 32767 + 0.5);
+    }
+    return t;
+}
+
+inline constexpr WaveTable kSine = makeSineTable();
+inline constexpr WaveTable kBreath = makeBreathTable();
+
+// 高 8 位查表，低 8 位线性插值
+inline int16_t lerp_table(const WaveTable &t, uint16_t phase) {
+    const uint8_t idx = phase >> 8;
+    const int32_t a = t.v[idx];
+    const int32_t b = t.v[idx + 1];
+    return (int16_t)(a + (((b - a) * (int32_t)(phase & 0xFF)) >> 8));
+}
+
+} // namespace wave_detail
+
+/**
+ * @brief 时间轴 -> 相位
+ * @param ms 特效时间 (ms)
+ * @param period_ms 周期 (ms)，需小于 65536
+ */
+inline uint16_t wave_phase(uint32_t ms, uint16_t period_ms) {
+    return (uint16_t)(((ms % period_ms) << 16) / period_ms);
+}
+
+/** @brief 正弦，Q15 [-32767, 32767]，相位 0 处为 0 */
+inline int16_t wave_sine(uint16_t phase) {
+    return wave_detail::lerp_table(wave_detail::kSine, phase);
+}
+
+/** @brief 呼吸曲线，Q15 [0, 32767]，相位 0 处为中间亮度并开始上升 */
+inline uint16_t wave_breath(uint16_t phase) {
+    return (uint16_t)wave_detail::lerp_table(wave_detail::kBreath, phase);
+}
+
+/** @brief 三角波，Q15 [0, 32767]，相位 0 处为 0，半周期处到顶 */
+inline uint16_t wave_triangle(uint16_t phase) {
+    return phase < 0x8000 ? phase : (uint16_t)(0xFFFF - phase);
+}
+
+/** @brief 缓入缓出 (smoothstep 3x^2 - 2x^3)，输入输出均为 Q15 [0, 32768] */
+inline uint16_t wave_ease(uint16_t x) {
+    if (x >= 0x8000) return 0x8000;
+    const uint32_t x2 = ((uint32_t)x * x) >> 15;
+    return (uint16_t)((x2 * (3u * 0x8000 - 2u * x)) >> 15);
+}
+
+/** @brief Q15 [0, 32768] 映射到 [lo, hi] 的 8 位值 */
+inline uint8_t wave_to_u8(uint16_t q15, uint8_t lo, uint8_t hi) {
+    return (uint8_t)(lo + (((uint32_t)(hi - lo) * q15) >> 15));
+}
@@ -0,0 +1,159 @@
+#include "lamp.hpp"
+#include "../ui/gui_task.hpp"
+
+// =================================================================================
+// 分区 (每块面板一个分区)
+//
+// 分区亮度是相对整灯亮度的比例：整灯调光/开关仍作用于全部面板，分区只在其上再缩放。
+// 分区颜色默认跟随整灯 (follow)，设置色温/RGB 后改为覆盖色，可再渐变回整灯颜色。
+// 分区色温直接换算为 RGB 覆盖色，色温之间的渐变在 m_colorSpace 中插值。
+//
+// 所有分区都处于默认状态时 m_zonesUniform = true，渲染走原来的整灯单色/单表路径；
+// 否则每个分区各算一次 PWM，逐块填色或缩放，仍是对 LED 的单次遍历。
+// =================================================================================
+
+/**
+ * @brief 重新判断是否所有分区都处于默认状态 (开、100%、跟随整灯颜色)
+ */
+void LampController::refreshZonesUniform() {
+    bool uniform = true;
+    for (const Zone &z : m_zones) {
+        if (!z.follow || z.releasing || z.levelQ16 != (100u << 16)) {
+            uniform = false;
+            break;
+        }
+    }
+    m_zonesUniform = uniform;
+}
+
+/**
+ * @brief 分区的输出亮度 (Q16，0 .. 100<<16) = 整灯亮度 x 分区亮度
+ */
+uint32_t LampController::zoneBrightnessQ16(const Zone &z) const {
+    const uint32_t scale = z.levelQ16 / 100; // Q16 比例 0 .. 65536
+    return (uint32_t)(((uint64_t)m_brightnessQ16 * scale) >> 16);
+}
+
+/**
+ * @brief 启动 (或立即切换) 分区覆盖色 from -> to
+ */
+void LampController::startZoneColor(uint8_t zone, const CRGB &from, const CRGB &to, uint32_t fade_ms) {
+    Zone &z = m_zones[zone];
+    z.fade.begin(m_colorSpace, from, to);
+    z.target = to;
+    if (fade_ms > 0) {
+        z.color = from;
+        m_tween.start(TWEEN_ZONE_COLOR + zone, 0, 65536, fade_ms, m_curve);
+    } else {
+        z.color = to;
+        m_tween.cancel(TWEEN_ZONE_COLOR + zone);
+    }
+}
+
+/**
+ * @brief 渐变步进后的收尾：渐变回整灯颜色的分区在结束时恢复跟随
+ */
+void LampController::finishZoneTweens() {
+    for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+        Zone &z = m_zones[i];
+        if (z.releasing && !m_tween.isActive(TWEEN_ZONE_COLOR + i)) {
+            z.releasing = false;
+            z.follow = true;
+        }
+    }
+    refreshZonesUniform();
+}
+
+/**
+ * @brief 修改分区状态 (LampTask)
+ *
+ * @param fields ZoneField 掩码，只修改被选中的字段
+ */
+void LampController::applyZone(uint8_t zone, const ZoneParams &params, uint8_t fields, uint32_t fade_ms,
+                               uint8_t excludeMask) {
+    if (zone >= LAMP_NUM_ZONES || fields == 0) return;
+    Zone &z = m_zones[zone];
+
+    // 1. 开关与亮度：同一条轨道，关闭即渐变到 0
+    if (fields & (ZF_ON | ZF_LEVEL)) {
+        if (fields & ZF_ON) z.on = params.on != 0;
+        if (fields & ZF_LEVEL) z.level = params.level < 1 ? 1 : (params.level > 100 ? 100 : params.level);
+
+        const uint32_t target = z.on ? (uint32_t)z.level << 16 : 0;
+        if (fade_ms > 0) {
+            m_tween.start(TWEEN_ZONE_LEVEL + zone, (int32_t)z.levelQ16, (int32_t)target, fade_ms, m_curve);
+        } else {
+            m_tween.cancel(TWEEN_ZONE_LEVEL + zone);
+            z.levelQ16 = target;
+        }
+    }
+
+    // 2. 颜色：从当前显示的颜色 (跟随时为整灯颜色) 起步
+    if (fields & (ZF_CCT | ZF_RGB)) {
+        CRGB target;
+        if (fields & ZF_CCT) {
+            uint16_t cct = params.cct;
+            if (cct < LAMP_CCT_MIN) cct = LAMP_CCT_MIN;
+            if (cct > LAMP_CCT_MAX) cct = LAMP_CCT_MAX;
+            z.cctMode = true;
+            z.cct = cct;
+            target = cct_to_rgb(cct, m_cctCal);
+        } else {
+            z.cctMode = false;
+            target = CRGB(params.r, params.g, params.b);
+        }
+        const CRGB from = z.follow ? baseColor() : z.color;
+        z.follow = false;
+        z.releasing = false;
+        startZoneColor(zone, from, target, fade_ms);
+    } else if ((fields & ZF_FOLLOW) && !z.follow) {
+        startZoneColor(zone, z.color, baseColor(), fade_ms);
+        z.releasing = fade_ms > 0;
+        z.follow = fade_ms == 0;
+    }
+
+    refreshZonesUniform();
+    update();
+
+    m_dirty_zones = true;
+    markChanged();
+
+    UIEvent evt{UI_EVENT_ZONE, zone};
+    send_ui_event(evt, excludeMask);
+}
+
+// =================================================================================
+// 持久化
+// =================================================================================
+
+void LampController::saveZonesToNVS() {
+    LampStateSnapshot::Zone cfg[LAMP_NUM_ZONES];
+    for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+        const Zone &z = m_zones[i];
+        cfg[i] = LampStateSnapshot::Zone{z.on, z.level, z.follow || z.releasing, z.cctMode, z.cct, z.target};
+    }
+    AppConfig::instance().begin();
+    AppConfig::instance().saveZones(cfg, sizeof(cfg));
+}
+
+/**
+ * @brief 从 NVS 恢复分区 (须在白点校准载入之后调用)
+ */
+void LampController::loadZonesFromNVS() {
+    LampStateSnapshot::Zone cfg[LAMP_NUM_ZONES];
+    if (!AppConfig::instance().loadZones(cfg, sizeof(cfg))) return;
+
+    for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+        const LampStateSnapshot::Zone &c = cfg[i];
+        Zone &z = m_zones[i];
+        z.on = c.on;
+        z.level = (c.level >= 1 && c.level <= 100) ? c.level : 100;
+        z.levelQ16 = z.on ? (uint32_t)z.level << 16 : 0;
+        z.follow = c.follow;
+        z.cctMode = c.cctMode;
+        z.cct = (c.cct >= LAMP_CCT_MIN && c.cct <= LAMP_CCT_MAX) ? c.cct : 4000;
+        z.target = z.cctMode ? cct_to_rgb(z.cct, m_cctCal) : c.rgb;
+        z.color = z.target;
+    }
+    refreshZonesUniform();
+}
@@ -55,14 +55,9 @@ static void task_button_process(void *pvParameters) {
             // if (digitalRead(PIN_BUTTON_INTERRUPT) == LOW) { ... } // 取决于电路逻辑
             
             // 切换 Lamp 内部逻辑开关并执行渐变
+            // 开关判断与 GUI 通知 (UI_EVENT_LIGHT) 由 LampTask 执行命令时完成
             lamp.togglePower(2000); // 2000ms 渐变
-            bool nowOn = lamp.isOn();
-            
-            Serial.printf("[Button] Light %s (brightness=%u)\n", nowOn ? "ON" : "OFF", lamp.getBrightness());
-            
-            // 通知 GUI 更新状态
-            UIEvent evt{UI_EVENT_LIGHT, nowOn ? 1 : 0};
-            send_ui_event(evt);
+            Serial.println("[Button] Toggle light");
 
             // 通知 MQTT 更新状态
             mqtt_report_state();
@@ -7,6 +7,7 @@
 #include "ble_task.hpp"
 #include "weather_task.hpp"
 #include "wifi_task.hpp"
+#include "udp_stream.hpp"
 #include "../app/lamp.hpp"
 #include "../system/storage.hpp"
 #include "../ui/gui_task.hpp"
@@ -20,6 +21,8 @@
 // =================================================================================
 
 static void handle_control_cmd(const char* str);
+static bool handle_overlay_cmd(const char* args);
+static void handle_palette_cmd(const char* args);
 static void handle_config_cmd(const String& cmdStr);
 static void send_status_report();
 
@@ -30,10 +33,13 @@ static void send_status_report();
 void ble_handle_command(const std::string& cmd) {
     const char* str = cmd.c_str();
 
-    // 1. 亮度控制 "bri:50"
+    // 1. 亮度控制 "bri:50"，可附渐变时长 "bri:100,1800000" (日出/睡眠等长渐变)
     if (strncmp(str, "bri:", 4) == 0) {
         int val = atoi(str + 4);
-        lamp.setBrightness(val, 500, DEST_BLE); 
+        const char* comma = strchr(str + 4, ',');
+        uint32_t fade = 500;
+        if (comma && !LampController::parseFadeMs(comma + 1, fade)) return;
+        lamp.setBrightness(val, fade, DEST_BLE); 
         return;
     }
     
@@ -65,17 +71,54 @@ void ble_handle_command(const std::string& cmd) {
         return;
     }
 
-    // 6. 场景控制 "scn:reading"
+    // 6. 场景控制 "scn:reading"；保存 "scs:movie,bri=20,rgb=255:80:0" (只给名称则保存当前状态)；删除 "scd:movie"
     if (strncmp(str, "scn:", 4) == 0) {
         lamp.setScene(str + 4, DEST_BLE);
         return;
     }
+    if (strncmp(str, "scs:", 4) == 0) {
+        lamp.saveScene(str + 4);
+        return;
+    }
+    if (strncmp(str, "scd:", 4) == 0) {
+        lamp.deleteScene(str + 4);
+        return;
+    }
 
-    // 7. 配置指令 (WiFi/MQTT/Weather)
+    // 7. 叠加层 "ovl:1,meteor,add,255" (混合方式 alpha/add/max 与不透明度可省略；特效 none 移除该层)
+    if (strncmp(str, "ovl:", 4) == 0) {
+        if (!handle_overlay_cmd(str + 4)) ble_send_notify("ovl:err");
+        return;
+    }
+
+    // 8. 调色板 "pal:fire" (当前特效) / "pal:meteor,ocean" (指定特效)
+    if (strncmp(str, "pal:", 4) == 0) {
+        handle_palette_cmd(str + 4);
+        return;
+    }
+
+    // 9. 特效参数 "efp:speed=200,intensity=90" (当前特效) / "efp:meteor,pal=ocean,dir=rev" (指定特效)
+    if (strncmp(str, "efp:", 4) == 0) {
+        lamp.setEffectParams(str + 4);
+        return;
+    }
+
+    // 10. 分区 "zon:2,bri=40,cct=3000" / "zon:3,off" / "zon:1,follow" (分区从 1 开始)
+    if (strncmp(str, "zon:", 4) == 0) {
+        lamp.setZone(str + 4, DEST_BLE);
+        return;
+    }
+
+    // 11. 配置指令 (WiFi/MQTT/Weather)
     // 使用 String 类处理较复杂的字符串操作
     handle_config_cmd(String(str));
 }
 
+void ble_handle_binary(const uint8_t* data, size_t len) {
+    const bool ok = lamp.handleFramePacket(data, len, DEST_BLE);
+    ble_send_notify(ok ? "frm:ok" : "frm:err");
+}
+
 // =================================================================================
 // 辅助逻辑实现
 // =================================================================================
@@ -90,38 +133,86 @@ static void handle_control_cmd(const char* action) {
     }
 }
 
+/**
+ * @brief 叠加层指令
+ *
+ * @return false 表示格式错误、未知特效或未知混合方式 (不做任何修改)
+ */
+static bool handle_overlay_cmd(const char* args) {
+    int layer = 0;
+    char name[16] = {0};
+    char blendName[8] = {0};
+    int alpha = 255;
+    if (sscanf(args, "%d,%15[^,],%7[^,],%d", &layer, name, blendName, &alpha) < 2) return false;
+
+    EffectMode mode;
+    if (!LampController::effectFromName(name, mode)) return false;
+
+    BlendMode blend = BlendMode::Add; // 省略时饱和相加
+    if (strcmp(blendName, "alpha") == 0) blend = BlendMode::Alpha;
+    else if (strcmp(blendName, "max") == 0) blend = BlendMode::Max;
+    else if (blendName[0] != '\0' && strcmp(blendName, "add") != 0) return false;
+
+    if (alpha < 0) alpha = 0;
+    if (alpha > 255) alpha = 255;
+    lamp.setOverlay((uint8_t)layer, mode, blend, (uint8_t)alpha);
+    return true;
+}
+
+static void handle_palette_cmd(const char* args) {
+    char effectName[16] = {0};
+    char paletteName[16] = {0};
+    PaletteId palette;
+
+    if (sscanf(args, "%15[^,],%15s", effectName, paletteName) == 2) {
+        EffectMode mode;
+        if (!LampController::effectFromName(effectName, mode) || !palette_from_name(paletteName, palette)) return;
+        lamp.setEffectPalette(mode, palette);
+    } else if (palette_from_name(args, palette)) {
+        lamp.setEffectPalette(palette);
+    }
+}
+
 static void send_status_report() {
     const TickType_t sendTimeout = pdMS_TO_TICKS(10);
     // 主动上报所有状态
     // 将状态上报请求放入队列，由 task_ble_event_handler 统一处理
     UIEvent evt;
+    LampStateSnapshot st;
+    lamp.getState(st);
     
     // 1. 开关状态
     evt.type = UI_EVENT_LIGHT;
-    evt.value = lamp.isOn() ? 1 : 0;
+    evt.value = st.on ? 1 : 0;
     xQueueSend(bleEventQueue, &evt, sendTimeout);
     
     // 2. 亮度
     evt.type = UI_EVENT_BRIGHTNESS;
-    evt.value = lamp.getBrightness();
+    evt.value = st.brightness;
     xQueueSend(bleEventQueue, &evt, sendTimeout);
     
     // 3. 模式与颜色
-    if (lamp.isCCTMode()) {
+    if (st.cctMode) {
         evt.type = UI_EVENT_CCT;
-        evt.value = lamp.getCCT();
+        evt.value = st.cct;
         xQueueSend(bleEventQueue, &evt, sendTimeout);
     } else {
         evt.type = UI_EVENT_RGB;
-        CRGB rgb = lamp.getRGB();
-        evt.value = ((uint32_t)rgb.r << 16) | ((uint32_t)rgb.g << 8) | rgb.b;
+        evt.value = ((uint32_t)st.rgb.r << 16) | ((uint32_t)st.rgb.g << 8) | st.rgb.b;
         xQueueSend(bleEventQueue, &evt, sendTimeout);
     }
     
     // 4. 特效
     evt.type = UI_EVENT_EFFECT;
-    evt.value = (int)lamp.getEffect();
+    evt.value = (int)st.effect;
     xQueueSend(bleEventQueue, &evt, sendTimeout);
+
+    // 5. 分区
+    evt.type = UI_EVENT_ZONE;
+    for (uint8_t i = 0; i < LampController::NUM_ZONES; i++) {
+        evt.value = i;
+        xQueueSend(bleEventQueue, &evt, sendTimeout);
+    }
 }
 
 static void handle_config_cmd(const String& cmdStr) {
@@ -223,6 +314,10 @@ static void handle_config_cmd(const String& cmdStr) {
         lamp.setAutoBrightness(val != 0);
         Serial.printf("[BLE] Auto Brightness: %d\n", val);
     }
+    // 实时像素流接收: "stream:on" / "stream:off"
+    else if (cmdStr == "stream:on" || cmdStr == "stream:off") {
+        udp_stream_set_enable(cmdStr == "stream:on");
+    }
     else {
         Serial.println("[BLE] 未知指令!");
     }
@@ -16,3 +16,10 @@
  * @param cmd 接收到的完整指令字符串 (不含结束符)
  */
 void ble_handle_command(const std::string& cmd);
+
+/**
+ * @brief 处理二进制帧指令 (首字节 FRAME_MAGIC，一次写入即一条完整指令，格式见 lamp_frame.hpp)
+ *
+ * 处理结果以 "frm:ok" / "frm:err" 通知，手机端据此逐帧上传动画。
+ */
+void ble_handle_binary(const uint8_t* data, size_t len);
@@ -89,6 +89,12 @@ class ConfigCallbacks: public NimBLECharacteristicCallbacks {
     void onWrite(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo& connInfo) override {
         // 获取写入的数据 (std::string)
         std::string rxValue = pCharacteristic->getValue();
+
+        // 二进制帧指令：单次写入即完整指令，不经过按行拼包
+        if (_rxBuffer.empty() && rxValue.length() >= 2 && (uint8_t)rxValue[0] == FRAME_MAGIC) {
+            ble_handle_binary((const uint8_t*)rxValue.data(), rxValue.length());
+            return;
+        }
         
         if (rxValue.length() > 0) {
             _rxBuffer += rxValue;
@@ -148,6 +154,31 @@ void task_ble_event_handler(void *pvParameters) {
                         evt.value & 0xFF);
                     ble_send_notify(buf);
                     break;
+                case UI_EVENT_SCENE:
+                    {
+                        LampStateSnapshot st;
+                        lamp.getState(st);
+                        snprintf(buf, sizeof(buf), "scn:%s", st.scene);
+                        ble_send_notify(buf);
+                        snprintf(buf, sizeof(buf), "bri:%d", st.savedBrightness);
+                        ble_send_notify(buf);
+                        if (st.cctMode) snprintf(buf, sizeof(buf), "cct:%d", st.cct);
+                        else snprintf(buf, sizeof(buf), "rgb:%d,%d,%d", st.rgb.r, st.rgb.g, st.rgb.b);
+                        ble_send_notify(buf);
+                    }
+                    break;
+                case UI_EVENT_ZONE:
+                    if (evt.value >= 0 && evt.value < LampController::NUM_ZONES) {
+                        LampStateSnapshot st;
+                        lamp.getState(st);
+                        const LampStateSnapshot::Zone &z = st.zones[evt.value];
+                        int n = snprintf(buf, sizeof(buf), "zon:%d,%s,bri=%d", evt.value + 1, z.on ? "on" : "off", z.level);
+                        if (z.follow) snprintf(buf + n, sizeof(buf) - n, ",follow");
+                        else if (z.cctMode) snprintf(buf + n, sizeof(buf) - n, ",cct=%d", z.cct);
+                        else snprintf(buf + n, sizeof(buf) - n, ",rgb=%d:%d:%d", z.rgb.r, z.rgb.g, z.rgb.b);
+                        ble_send_notify(buf);
+                    }
+                    break;
                 case UI_EVENT_LUX:
                     snprintf(buf, sizeof(buf), "lux:%.1f", evt.fvalue);
                     ble_send_notify(buf);
@@ -170,14 +201,9 @@ void task_ble_event_handler(void *pvParameters) {
                     break;
                 case UI_EVENT_EFFECT:
                     {
-                        const char* effStr = "none";
-                        switch((EffectMode)evt.value) {
-                            case EffectMode::Rainbow: effStr = "rainbow"; break;
-                            case EffectMode::Breathing: effStr = "breathing"; break;
-                            case EffectMode::Police: effStr = "police"; break;
-                            default: effStr = "none"; break;
-                        }
-                        snprintf(buf, sizeof(buf), "eff:%s", effStr);
+                        // BLE 协议使用小写特效名
+                        int n = snprintf(buf, sizeof(buf), "eff:%s", effect_name((EffectMode)evt.value));
+                        for (int i = 4; i < n && i < (int)sizeof(buf); i++) buf[i] = (char)tolower((unsigned char)buf[i]);
                         ble_send_notify(buf);
                     }
                     break;
@@ -1,4 +1,5 @@
 #include "mqtt_ha.hpp"
+#include "../app/lamp.hpp"
 
 /**
  * @brief 辅助函数：发送单个传感器的配置
@@ -105,6 +106,60 @@ void ha_publish_light_discovery(PubSubClient& client, const DeviceInfo& dev, con
     }
 }
 
+void ha_publish_zone_discovery(PubSubClient& client, const DeviceInfo& dev, const MqttTopics& topics) {
+    if (!client.connected()) return;
+
+    for (uint8_t i = 1; i <= LampController::NUM_ZONES; i++) {
+        const String base = topics.zone_prefix + String(i);
+        const String state = base + "/state";
+        String discovery_topic = "homeassistant/light/" + dev.nodeId + "/zone" + String(i) + "/config";
+
+        String payload;
+        payload.reserve(1536);
+
+        payload = "{";
+        payload += "\"name\":\"Panel " + String(i) + "\",";
+        payload += "\"uniq_id\":\"" + dev.nodeId + "_zone" + String(i) + "\",";
+
+        payload += "\"avty_t\":\"" + topics.availability + "\",";
+        payload += "\"cmd_t\":\"" + base + "/switch/set\",";
+        payload += "\"stat_t\":\"" + state + "\",";
+        payload += "\"stat_val_tpl\":\"{{ value_json.state }}\",";
+
+        // 分区亮度相对整灯亮度
+        payload += "\"bri_cmd_t\":\"" + base + "/brightness/set\",";
+        payload += "\"bri_stat_t\":\"" + state + "\",";
+        payload += "\"bri_val_tpl\":\"{{ value_json.brightness }}\",";
+        payload += "\"bri_scl\":100,";
+
+        payload += "\"color_mode\":true,";
+        payload += "\"supported_color_modes\":[\"color_temp\",\"rgb\"],";
+
+        payload += "\"clrm_stat_t\":\"" + state + "\",";
+        payload += "\"clrm_val_tpl\":\"{{ value_json.color_mode }}\",";
+
+        payload += "\"clr_temp_cmd_t\":\"" + base + "/cct/set\",";
+        payload += "\"clr_temp_stat_t\":\"" + state + "\",";
+        payload += "\"clr_temp_val_tpl\":\"{{ (1000000 / value_json.cct) | int }}\",";
+        payload += "\"min_mireds\":153,";
+        payload += "\"max_mireds\":370,";
+
+        payload += "\"rgb_cmd_t\":\"" + base + "/rgb/set\",";
+        payload += "\"rgb_stat_t\":\"" + state + "\",";
+        payload += "\"rgb_val_tpl\":\"{{ value_json.rgb.r }},{{ value_json.rgb.g }},{{ value_json.rgb.b }}\",";
+
+        // Device Registry
+        payload += "\"dev\":{";
+        payload += "\"ids\":[\"" + dev.nodeId + "\"],";
+        payload += "\"name\":\"" + dev.name + "\",";
+        payload += "\"mdl\":\"" + dev.model + "\",";
+        payload += "\"mf\":\"" + dev.manufacturer + "\"";
+        payload += "}}";
+
+        client.publish(discovery_topic.c_str(), payload.c_str(), true);
+    }
+}
+
 /**
  * @brief 辅助函数：发送按钮配置
  */
@@ -241,25 +296,27 @@ void ha_publish_system_discovery(PubSubClient& client, const DeviceInfo& dev, co
     send_diagnostic_config(client, dev, "uptime", "Uptime", nullptr, "duration", "s",
                            topics.system_info, "{{ value_json.uptime }}", topics.availability);
 
-    // 6. 灯光效果选择器
-    const char* effect_options = "[\"None\",\"Rainbow\",\"Breathing\",\"Police\",\"Spin\",\"Meteor\"]";
+    // 6. LED 帧输出统计 (实际 show / 因像素未变化跳过)
+    send_diagnostic_config(client, dev, "frames_shown", "LED Frames Shown", "mdi:led-strip", nullptr, nullptr,
+                           topics.system_info, "{{ value_json.frames_shown }}", topics.availability);
+    send_diagnostic_config(client, dev, "frames_skipped", "LED Frames Skipped", "mdi:led-strip-variant-off", nullptr, nullptr,
+                           topics.system_info, "{{ value_json.frames_skipped }}", topics.availability);
+
+    // 7. 灯光效果选择器
+    // 选项与 publish_state / BLE 使用同一张名称表
+    char options[192];
+    kEffectNames.toJson(options, sizeof(options));
     send_select_config(client, dev, "effect", "Light Effect", "mdi:palette", "config",
-                       topics.effect_set, topics.state, "{{ value_json.effect }}", effect_options, topics.availability);
-
-    // 7. 场景模式选择器
-    const char* scene_options = "[\"None\",\"Reading\",\"Night\",\"Cozy\",\"Bright\"]";
-    // 注意：这里我们没有专门的 scene 状态字段，通常场景是触发式的。
-    // 但为了让 Select 实体能显示当前状态，我们可以假定如果当前没有特效且符合某个场景的参数，就显示该场景。
-    // 简化起见，我们暂时不回显场景状态，或者复用 effect 字段？不，effect 字段只显示特效。
-    // 如果用户选择了场景，Select 会短暂显示该场景，然后可能变回 None (如果状态没更新)。
-    // 为了更好的体验，我们可以在 state JSON 中增加 scene 字段，或者只是让它作为触发器。
-    // 这里我们暂时让它作为触发器，状态回显可能不准确，除非我们在 lamp_core 中维护 currentScene 状态。
-    // 鉴于 lamp_core 中 setScene 只是设置参数，没有维护状态，我们这里 state_topic 留空或者使用一个假的。
-    // 但 HA Select 需要 state_topic 来显示当前值。
-    // 让我们暂时使用 topics.state 和一个不存在的 json 路径，这样它可能始终显示 Unknown 或第一个值？
-    // 或者更好的做法是：在 lamp_core 中增加 m_currentScene 变量。
-    // 考虑到修改量，我们暂时让它共用 topics.state，但在 JSON 中我们需要增加 "scene" 字段。
-    // 我会在 mqtt_task.cpp 的 publish_state 中增加 scene 字段。
+                       topics.effect_set, topics.state, "{{ value_json.effect }}", options, topics.availability);
+
+    // 8. 当前特效的调色板选择器
+    kPaletteNames.toJson(options, sizeof(options));
+    send_select_config(client, dev, "palette", "Effect Palette", "mdi:palette-swatch", "config",
+                       topics.palette_set, topics.state, "{{ value_json.palette }}", options, topics.availability);
+
+    // 9. 场景模式选择器
+    // 状态回显读取 state JSON 的 scene 字段 (当前场景槽位对应的名称)；仅列出内置场景
+    kSceneNames.toJson(options, sizeof(options));
     send_select_config(client, dev, "scene", "Light Scene", "mdi:home-lightbulb", "config",
-                       topics.scene_set, topics.state, "{{ value_json.scene }}", scene_options, topics.availability);
+                       topics.scene_set, topics.state, "{{ value_json.scene }}", options, topics.availability);
 }
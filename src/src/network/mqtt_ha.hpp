@@ -14,8 +14,16 @@ struct MqttTopics {
     String brightness_set;
     String cct_set;
     String rgb_set;
+    String cct_cal_set;     // 白点校准矩阵 (9 个系数或 "reset")
     String effect_set;
+    String palette_set;     // 特效调色板 ("fire" 或 "meteor,ocean")
+    String effect_params_set; // 特效参数 ("speed=200,intensity=90" 或 "meteor,pal=ocean,dir=rev")
     String scene_set;       // 场景设置
+    String scene_store;     // 保存用户场景 ("name[,bri=][,cct=|rgb=r:g:b][,fade=]")
+    String scene_delete;    // 删除用户场景 (场景名)
+    String frame_set;       // 二进制帧指令 (格式见 lamp_frame.hpp)
+    String zone_set;        // 分区文本指令 ("2,bri=40,cct=3000" / "1,follow")
+    String zone_prefix;     // 分区主题前缀 "<prefix>/zone/"，其后为 "<n>/switch/set"、"<n>/state" 等 (n 从 1 开始)
     
     String system_set;      // 系统控制
     String system_info;     // 系统信息 (JSON)
@@ -46,6 +54,11 @@ void ha_publish_sensor_discovery(PubSubClient& client, const DeviceInfo& dev, co
  */
 void ha_publish_light_discovery(PubSubClient& client, const DeviceInfo& dev, const MqttTopics& topics);
 
+/**
+ * @brief 发布 Home Assistant 自动发现配置 (每块面板一个灯光实体)
+ */
+void ha_publish_zone_discovery(PubSubClient& client, const DeviceInfo& dev, const MqttTopics& topics);
+
 /**
  * @brief 发布 Home Assistant 自动发现配置 (系统实体: 按钮、诊断信息)
  */
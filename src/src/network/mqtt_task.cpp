@@ -8,6 +8,7 @@
 
 #include "mqtt_task.hpp"
 #include "mqtt_ha.hpp"
+#include "udp_stream.hpp"
 
 // Project Headers
 #include "../system/storage.hpp"
@@ -44,6 +45,9 @@ static DeviceInfo g_deviceInfo;
 
 // 状态变更标志
 static volatile bool g_state_changed = false;
+static uint32_t s_publishedStateVersion = 0; // 最近一次上报的灯光快照版本
+static LampStateSnapshot::Zone s_publishedZones[LAMP_NUM_ZONES]; // 最近一次上报的分区状态
+static bool s_zonesPublished = false;                            // false = 下次全部重发 (重连后)
 
 // =================================================================================
 // 内部辅助函数声明
@@ -56,8 +60,14 @@ static void handle_switch(char* msg);
 static void handle_brightness(char* msg);
 static void handle_cct(char* msg);
 static void handle_rgb(char* msg);
+static void handle_cct_calibration(char* msg);
 static void handle_effect(char* msg);
+static void handle_palette(char* msg);
+static void handle_effect_params(char* msg);
 static void handle_scene(char* msg);
+static void handle_scene_store(char* msg);
+static void handle_scene_delete(char* msg);
+static void handle_zone(const char* sub, char* msg);
 static void handle_system(char* msg);
 
 // =================================================================================
@@ -73,6 +83,13 @@ void mqtt_callback(char* topic, byte* payload, unsigned int length) {
         return;
     }
     
+    // 二进制帧指令不做文本处理
+    if (strcmp(topic, g_topics.frame_set.c_str()) == 0) {
+        if (lamp.handleFramePacket(payload, length, DEST_MQTT)) g_state_changed = true;
+        else Serial.println("[MQTT] Invalid frame packet");
+        return;
+    }
+
     char msgBuf[256];
     memcpy(msgBuf, payload, length);
     msgBuf[length] = '\0';
@@ -97,15 +114,36 @@ void mqtt_callback(char* topic, byte* payload, unsigned int length) {
     else if (strcmp(topic, g_topics.rgb_set.c_str()) == 0) {
         handle_rgb(msgPtr);
     }
+    else if (strcmp(topic, g_topics.cct_cal_set.c_str()) == 0) {
+        handle_cct_calibration(msgPtr);
+    }
     else if (strcmp(topic, g_topics.effect_set.c_str()) == 0) {
         handle_effect(msgPtr);
     }
+    else if (strcmp(topic, g_topics.palette_set.c_str()) == 0) {
+        handle_palette(msgPtr);
+    }
+    else if (strcmp(topic, g_topics.effect_params_set.c_str()) == 0) {
+        handle_effect_params(msgPtr);
+    }
     else if (strcmp(topic, g_topics.scene_set.c_str()) == 0) {
         handle_scene(msgPtr);
     }
+    else if (strcmp(topic, g_topics.scene_store.c_str()) == 0) {
+        handle_scene_store(msgPtr);
+    }
+    else if (strcmp(topic, g_topics.scene_delete.c_str()) == 0) {
+        handle_scene_delete(msgPtr);
+    }
     else if (strcmp(topic, g_topics.system_set.c_str()) == 0) {
         handle_system(msgPtr);
     }
+    else if (strcmp(topic, g_topics.zone_set.c_str()) == 0) {
+        if (lamp.setZone(msgPtr, DEST_MQTT)) g_state_changed = true;
+    }
+    else if (strncmp(topic, g_topics.zone_prefix.c_str(), g_topics.zone_prefix.length()) == 0) {
+        handle_zone(topic + g_topics.zone_prefix.length(), msgPtr);
+    }
 }
 
 static void handle_switch(char* msg) {
@@ -130,10 +168,19 @@ static void handle_switch(char* msg) {
     }
 }
 
+/**
+ * @brief 亮度："50"，或附渐变时长 "100,1800000" (ms，日出/睡眠等长渐变)
+ */
 static void handle_brightness(char* msg) {
     int val = atoi(msg);
+    const char* comma = strchr(msg, ',');
+    uint32_t fade = 500;
+    if (comma && !LampController::parseFadeMs(comma + 1, fade)) {
+        Serial.println("[MQTT] Invalid brightness fade, expected <0-100>[,<fade_ms>]");
+        return;
+    }
     if (val >= 0 && val <= 100) {
-        lamp.setBrightness(val, 500, DEST_MQTT); 
+        lamp.setBrightness(val, fade, DEST_MQTT); 
         UIEvent evt = {UI_EVENT_BRIGHTNESS, val};
         send_ui_event(evt, DEST_MQTT);
         g_state_changed = true;
@@ -163,13 +210,104 @@ static void handle_rgb(char* msg) {
     }
 }
 
+/**
+ * @brief 白点校准："1.0,0,0,0,0.92,0,0,0,0.85" (3x3 行优先) 或 "reset"
+ */
+static void handle_cct_calibration(char* msg) {
+    if (!lamp.setCctCalibration(msg)) {
+        Serial.println("[MQTT] Invalid CCT calibration, expected 9 comma-separated values or 'reset'");
+    }
+}
+
 static void handle_effect(char* msg) {
     lamp.setEffect(msg);
     g_state_changed = true;
 }
 
+/**
+ * @brief 调色板："fire" 作用于当前特效，"meteor,ocean" 指定特效 (与 BLE "pal:" 相同)
+ */
+static void handle_palette(char* msg) {
+    char* sep = strchr(msg, ',');
+    PaletteId palette;
+    if (sep) {
+        *sep = '\0';
+        EffectMode mode;
+        if (!LampController::effectFromName(msg, mode) || !palette_from_name(sep + 1, palette)) return;
+        lamp.setEffectPalette(mode, palette);
+    } else {
+        if (!palette_from_name(msg, palette)) return;
+        lamp.setEffectPalette(palette);
+    }
+    g_state_changed = true;
+}
+
+/**
+ * @brief 特效参数："speed=200,intensity=90" 作用于当前特效，"meteor,pal=ocean,dir=rev" 指定特效
+ */
+static void handle_effect_params(char* msg) {
+    if (lamp.setEffectParams(msg)) g_state_changed = true;
+}
+
 static void handle_scene(char* msg) {
-    lamp.setScene(msg, DEST_MQTT);
+    if (!lamp.setScene(msg, DEST_MQTT)) {
+        Serial.println("[MQTT] Invalid scene name (max 11 characters)");
+        return;
+    }
+    g_state_changed = true;
+}
+
+/**
+ * @brief 保存用户场景："Movie,bri=20,rgb=255:80:0,fade=1500"；只给名称则保存当前状态
+ */
+static void handle_scene_store(char* msg) {
+    if (!lamp.saveScene(msg)) {
+        Serial.println("[MQTT] Invalid scene, expected name[,bri=][,cct=|rgb=r:g:b][,fade=]");
+    }
+}
+
+static void handle_scene_delete(char* msg) {
+    if (!lamp.deleteScene(msg)) Serial.println("[MQTT] Invalid scene name (max 11 characters)");
+}
+
+/**
+ * @brief 分区灯光实体："<n>/switch/set"、"<n>/brightness/set"、"<n>/cct/set"、"<n>/rgb/set" (n 从 1 开始)
+ */
+static void handle_zone(const char* sub, char* msg) {
+    unsigned n = 0;
+    char what[16];
+    if (sscanf(sub, "%u/%15[^/]/set", &n, what) != 2 || n < 1 || n > LampController::NUM_ZONES) return;
+
+    ZoneParams p{};
+    uint8_t fields = 0;
+    if (strcmp(what, "switch") == 0) {
+        if (strcasecmp(msg, "ON") == 0 || strcmp(msg, "1") == 0) p.on = 1;
+        else if (strcasecmp(msg, "OFF") == 0 || strcmp(msg, "0") == 0) p.on = 0;
+        else return;
+        fields = ZF_ON;
+    } else if (strcmp(what, "brightness") == 0) {
+        int val = atoi(msg);
+        if (val < 1 || val > 100) return;
+        p.level = (uint8_t)val;
+        fields = ZF_LEVEL;
+    } else if (strcmp(what, "cct") == 0) {
+        int val = atoi(msg);
+        if (val > 0 && val < 1000) val = 1000000 / val; // Mireds
+        if (val < 2700 || val > 6500) return;
+        p.cct = (uint16_t)val;
+        fields = ZF_CCT;
+    } else if (strcmp(what, "rgb") == 0) {
+        int r, g, b;
+        if (sscanf(msg, "%d,%d,%d", &r, &g, &b) != 3) return;
+        if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) return;
+        p.r = (uint8_t)r;
+        p.g = (uint8_t)g;
+        p.b = (uint8_t)b;
+        fields = ZF_RGB;
+    } else {
+        return;
+    }
+    lamp.setZone((uint8_t)(n - 1), p, fields, 500, DEST_MQTT);
     g_state_changed = true;
 }
 
@@ -188,8 +326,13 @@ static void handle_system(char* msg) {
         // 强制重发 HA 发现配置
         ha_publish_sensor_discovery(client, g_deviceInfo, g_topics);
         ha_publish_light_discovery(client, g_deviceInfo, g_topics);
+        ha_publish_zone_discovery(client, g_deviceInfo, g_topics);
         ha_publish_system_discovery(client, g_deviceInfo, g_topics);
     }
+    else if (cmd == "stream:on" || cmd == "stream:off") {
+        // 实时像素流接收 (DDP / E1.31)，无认证，默认关闭
+        udp_stream_set_enable(cmd == "stream:on");
+    }
 }
 
 // =================================================================================
@@ -199,10 +342,15 @@ static void handle_system(char* msg) {
 static void publish_system_info(bool retain) {
     if (!client.connected()) return;
 
+    uint32_t framesShown, framesSkipped;
+    lamp.getFrameStats(framesShown, framesSkipped);
+
     String info = "{";
     info += "\"ip\":\"" + WiFi.localIP().toString() + "\",";
     info += "\"rssi\":" + String(WiFi.RSSI()) + ",";
-    info += "\"uptime\":" + String(millis() / 1000);
+    info += "\"uptime\":" + String(millis() / 1000) + ",";
+    info += "\"frames_shown\":" + String(framesShown) + ",";
+    info += "\"frames_skipped\":" + String(framesSkipped);
     info += "}";
     client.publish(g_topics.system_info.c_str(), info.c_str(), retain);
 }
@@ -222,41 +370,72 @@ static void publish_sensors() {
         client.publish(g_topics.sensor_humi.c_str(), h.c_str());
     }
 
-    // 发布系统信息 (IP, RSSI, Uptime)
+    // 发布系统信息 (IP, RSSI, Uptime, 帧统计)
     publish_system_info(true);
 }
 
+static bool same_zone(const LampStateSnapshot::Zone &a, const LampStateSnapshot::Zone &b) {
+    return a.on == b.on && a.level == b.level && a.follow == b.follow && a.cctMode == b.cctMode &&
+           a.cct == b.cct && a.rgb == b.rgb;
+}
+
+/**
+ * @brief 发布分区状态 (只发布有变化的分区，重连后全部重发)
+ */
+static void publish_zones(const LampStateSnapshot &st) {
+    for (uint8_t i = 0; i < LAMP_NUM_ZONES; i++) {
+        const LampStateSnapshot::Zone &z = st.zones[i];
+        if (s_zonesPublished && same_zone(z, s_publishedZones[i])) continue;
+
+        char jsonBuf[160];
+        snprintf(jsonBuf, sizeof(jsonBuf),
+            "{\"state\":\"%s\",\"brightness\":%d,\"color_mode\":\"%s\",\"cct\":%d,\"rgb\":{\"r\":%d,\"g\":%d,\"b\":%d},\"follow\":%s}",
+            z.on ? "ON" : "OFF",
+            z.level,
+            z.cctMode ? "color_temp" : "rgb",
+            z.cct,
+            z.rgb.r,
+            z.rgb.g,
+            z.rgb.b,
+            z.follow ? "true" : "false"
+        );
+        const String topic = g_topics.zone_prefix + String(i + 1) + "/state";
+        client.publish(topic.c_str(), jsonBuf);
+        s_publishedZones[i] = z;
+    }
+    s_zonesPublished = true;
+}
+
 static void publish_state() {
     if (!client.connected()) return;
     
+    LampStateSnapshot st;
+    s_publishedStateVersion = lamp.getState(st);
+
     char jsonBuf[384]; 
-    int displayBri = lamp.getSavedBrightness();
-    
-    const char* effectStr = "None";
-    switch(lamp.getEffect()) {
-        case EffectMode::Rainbow:  effectStr = "Rainbow"; break;
-        case EffectMode::Breathing:effectStr = "Breathing"; break;
-        case EffectMode::Police:     effectStr = "Police"; break;
-        case EffectMode::Spin:     effectStr = "Spin"; break;
-        case EffectMode::Meteor:   effectStr = "Meteor"; break;
-        default: effectStr = "None"; break;
-    }
+    int displayBri = st.savedBrightness;
     
     snprintf(jsonBuf, sizeof(jsonBuf), 
-        "{\"state\":\"%s\",\"brightness\":%d,\"color_mode\":\"%s\",\"cct\":%d,\"rgb\":{\"r\":%d,\"g\":%d,\"b\":%d},\"effect\":\"%s\",\"scene\":\"%s\"}",
-        lamp.isOn() ? "ON" : "OFF",
+        "{\"state\":\"%s\",\"brightness\":%d,\"color_mode\":\"%s\",\"cct\":%d,\"rgb\":{\"r\":%d,\"g\":%d,\"b\":%d},\"effect\":\"%s\",\"palette\":\"%s\",\"speed\":%d,\"intensity\":%d,\"reverse\":%s,\"scene\":\"%s\",\"live\":%s}",
+        st.on ? "ON" : "OFF",
         displayBri,
-        lamp.isCCTMode() ? "color_temp" : "rgb",
-        lamp.getCCT(),
-        lamp.getRGB().r,
-        lamp.getRGB().g,
-        lamp.getRGB().b,
-        effectStr,
-        lamp.getScene().c_str()
+        st.cctMode ? "color_temp" : "rgb",
+        st.cct,
+        st.rgb.r,
+        st.rgb.g,
+        st.rgb.b,
+        effect_name(st.effect),
+        palette_name(st.params.palette),
+        st.params.speed,
+        st.params.intensity,
+        st.params.reverse ? "true" : "false",
+        st.scene,
+        st.live ? "true" : "false"
     );
     
     client.publish(g_topics.state.c_str(), jsonBuf);
-    client.publish(g_topics.switch_state.c_str(), lamp.isOn() ? "ON" : "OFF");
+    client.publish(g_topics.switch_state.c_str(), st.on ? "ON" : "OFF");
+    publish_zones(st);
     
     if (g_topics.availability.length() > 0) {
         client.publish(g_topics.availability.c_str(), "online", true);
@@ -293,6 +472,7 @@ void mqtt_reconnect() {
 
             if (willTopic) client.publish(willTopic, "online", true);
             
+            s_zonesPublished = false;
             publish_state();
             
             // 订阅
@@ -300,15 +480,24 @@ void mqtt_reconnect() {
             client.subscribe(g_topics.brightness_set.c_str());
             client.subscribe(g_topics.cct_set.c_str());
             client.subscribe(g_topics.rgb_set.c_str());
+            client.subscribe(g_topics.cct_cal_set.c_str());
             client.subscribe(g_topics.effect_set.c_str());
+            client.subscribe(g_topics.palette_set.c_str());
+            client.subscribe(g_topics.effect_params_set.c_str());
             client.subscribe(g_topics.scene_set.c_str());
+            client.subscribe(g_topics.scene_store.c_str());
+            client.subscribe(g_topics.scene_delete.c_str());
             client.subscribe(g_topics.system_set.c_str());
+            client.subscribe(g_topics.zone_set.c_str());
+            client.subscribe(g_topics.frame_set.c_str());
+            client.subscribe((g_topics.zone_prefix + "+/+/set").c_str());
             
             Serial.println("[MQTT] Subscribed to topics");
 
             // 发布 HA 发现配置
             ha_publish_sensor_discovery(client, g_deviceInfo, g_topics);
             ha_publish_light_discovery(client, g_deviceInfo, g_topics);
+            ha_publish_zone_discovery(client, g_deviceInfo, g_topics);
             ha_publish_system_discovery(client, g_deviceInfo, g_topics);
             
         } else {
@@ -343,8 +532,16 @@ static void init_topics() {
     g_topics.brightness_set = g_topics.prefix + "/brightness/set";
     g_topics.cct_set = g_topics.prefix + "/cct/set";
     g_topics.rgb_set = g_topics.prefix + "/rgb/set";
+    g_topics.cct_cal_set = g_topics.prefix + "/cct/calibration/set";
     g_topics.effect_set = g_topics.prefix + "/effect/set";
+    g_topics.palette_set = g_topics.prefix + "/effect/palette/set";
+    g_topics.effect_params_set = g_topics.prefix + "/effect/params/set";
     g_topics.scene_set = g_topics.prefix + "/scene/set";
+    g_topics.scene_store = g_topics.prefix + "/scene/store";
+    g_topics.scene_delete = g_topics.prefix + "/scene/delete";
+    g_topics.frame_set = g_topics.prefix + "/frame";
+    g_topics.zone_set = g_topics.prefix + "/zone/set";
+    g_topics.zone_prefix = g_topics.prefix + "/zone/";
     
     g_topics.sensor_lux = g_topics.prefix + "/sensor/lux";
     g_topics.sensor_temp = g_topics.prefix + "/sensor/temp";
@@ -382,23 +579,25 @@ static void task_mqtt(void *pvParameters) {
             if (!client.connected()) {
                 mqtt_reconnect();
             }
-            client.loop();
-
             uint32_t now = millis();
 
-            // 心跳包 (5s)
-            if (now - lastPub > 5000) {
-                lastPub = now;
-                publish_state();
-            }
-            
             // 状态变更立即上报 (限流 200ms)
+            // 放在 client.loop() 之前：本轮回调投递的灯光命令要等 LampTask 取出执行，
+            // 下一轮 (10ms 后) 再上报才能读到新状态。
             if (g_state_changed && (now - lastResponsePub > 200)) {
                 g_state_changed = false;
                 lastResponsePub = now;
                 publish_state();
             }
 
+            client.loop();
+
+            // 心跳包 (5s)
+            if (now - lastPub > 5000) {
+                lastPub = now;
+                publish_state();
+            }
+
             // 处理事件队列
             if (mqttEventQueue) {
                 UIEvent evt;
@@ -417,7 +616,12 @@ static void task_mqtt(void *pvParameters) {
                         case UI_EVENT_BRIGHTNESS:
                         case UI_EVENT_CCT:
                         case UI_EVENT_RGB:
-                            publish_state();
+                        case UI_EVENT_SCENE:
+                        case UI_EVENT_ZONE:
+                            // 同一次变化可能产生多个事件，快照版本未变时不重复上报
+                            if (lamp.stateVersion() != s_publishedStateVersion) {
+                                publish_state();
+                            }
                             break;
                         default: break;
                     }
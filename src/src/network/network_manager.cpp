@@ -3,6 +3,7 @@
 #include "ble_task.hpp"
 #include "mqtt_task.hpp"
 #include "weather_task.hpp"
+#include "udp_stream.hpp"
 #include <WiFi.h>
 
 NetworkManager& NetworkManager::instance() {
@@ -36,6 +37,9 @@ void NetworkManager::setup() {
     // 5. 启动天气任务
     setup_weather_task();
 
+    // 6. 启动实时像素流接收 (DDP / E1.31)
+    setup_udp_stream_task();
+
     Serial.println("[Network] All network services started.");
 }
 
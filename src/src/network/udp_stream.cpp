@@ -0,0 +1,346 @@
+#include "udp_stream.hpp"
+#include "../app/lamp.hpp"
+#include "../system/storage.hpp"
+#include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <string.h>
+
+// =================================================================================
+// 全局变量 (Global Variables)
+// =================================================================================
+
+static TaskHandle_t s_streamTaskHandle = nullptr;
+static volatile bool s_enabled = false;
+static UdpStreamStats s_stats{};
+static uint32_t s_lastRxMs = 0;
+
+// =================================================================================
+// 配置与常量 (Configuration & Constants)
+// =================================================================================
+
+static constexpr uint32_t kLedBytes = LAMP_NUM_LEDS * 3;
+static_assert(sizeof(CRGB) == 3, "像素直接收进后缓冲，要求 CRGB 为紧凑的 r,g,b");
+
+// DDP (Distributed Display Protocol)：10 字节头部，带时间码时 14 字节
+static constexpr size_t kDdpHeaderLen = 10;
+static constexpr size_t kDdpTimecodeLen = 4;
+static constexpr uint8_t kDdpVersionMask = 0xC0;
+static constexpr uint8_t kDdpVersion1 = 0x40;
+static constexpr uint8_t kDdpFlagTimecode = 0x10;
+static constexpr uint8_t kDdpFlagQuery = 0x02;
+static constexpr uint8_t kDdpFlagPush = 0x01;
+static constexpr uint8_t kDdpIdDisplay = 1;
+static constexpr uint8_t kDdpIdAll = 255;
+
+// E1.31 (sACN)：根层 + 帧层 + DMP 层共 126 字节，随后为 DMX 通道数据
+static constexpr size_t kE131HeaderLen = 126;
+static constexpr uint16_t kE131UniverseBytes = 510; // 每个 universe 170 个像素 (像素不跨 universe)
+static constexpr uint16_t kE131Universes = (kLedBytes + kE131UniverseBytes - 1) / kE131UniverseBytes;
+static constexpr uint8_t kE131OptPreview = 0x80;
+static constexpr uint8_t kE131OptTerminated = 0x40;
+static const uint8_t kE131AcnId[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+
+static constexpr int kMaxPacketsPerWake = 8; // 每次 select() 返回后每个套接字最多处理的包数
+// 与 LampTask / MQTT / GUI 同优先级，每个包后让出 CPU：单核 C3 上包洪泛也不会饿死这些任务
+static constexpr UBaseType_t kStreamTaskPriority = 1;
+
+// 已校验的数据包：像素数据写到后缓冲的 [offset, offset + len)
+struct StreamPacket {
+    size_t hdrLen;
+    uint32_t offset;
+    uint32_t len;
+    bool push;
+};
+
+enum class PacketResult : uint8_t { Accept, Stale, Invalid, Terminated };
+
+// 序号：DDP 为 4 位 (1-15，0 = 不使用)，E1.31 为 8 位；0 表示尚未收到
+static uint8_t s_ddpSeq = 0;
+static uint8_t s_e131Seq[kE131Universes];
+static bool s_e131SeqValid[kE131Universes];
+
+// E1.31 当前发送端 (根层 CID)：流进行中只接受它的数据与 Stream_Terminated
+static constexpr size_t kE131CidOffset = 22;
+static constexpr size_t kE131CidLen = 16;
+static uint8_t s_e131Cid[kE131CidLen];
+static bool s_e131CidValid = false;
+
+// =================================================================================
+// 内部函数 (Internal Functions)
+// =================================================================================
+
+static inline uint16_t rd16(const uint8_t* p) { return (uint16_t)((p[0] << 8) | p[1]); }
+static inline uint32_t rd32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief 发送端停止超过 STREAM_TIMEOUT_MS 后视为新的流，序号重新开始
+ */
+static void reset_sequences_if_idle(uint32_t now) {
+    if (now - s_lastRxMs < LampController::STREAM_TIMEOUT_MS) return;
+    s_ddpSeq = 0;
+    memset(s_e131SeqValid, 0, sizeof(s_e131SeqValid));
+    s_e131CidValid = false;
+}
+
+static PacketResult parse_ddp(const uint8_t* h, size_t n, StreamPacket& out) {
+    if (n < kDdpHeaderLen) return PacketResult::Invalid;
+
+    const uint8_t flags = h[0];
+    if ((flags & kDdpVersionMask) != kDdpVersion1 || (flags & kDdpFlagQuery)) return PacketResult::Invalid;
+    const uint8_t type = h[2];
+    if (type != 0x00 && type != 0x01 && type != 0x0B) return PacketResult::Invalid; // 未定义 / 旧版 RGB / RGB 8 位
+    if (h[3] != kDdpIdDisplay && h[3] != kDdpIdAll) return PacketResult::Invalid;
+
+    const size_t hdrLen = kDdpHeaderLen + ((flags & kDdpFlagTimecode) ? kDdpTimecodeLen : 0);
+    if (n < hdrLen) return PacketResult::Invalid;
+
+    const uint32_t offset = rd32(h + 4);
+    uint32_t len = rd16(h + 8);
+    if (offset >= kLedBytes) return PacketResult::Invalid;
+    if (len > kLedBytes - offset) len = kLedBytes - offset;
+
+    // 4 位序号：与上一包相差 1..7 视为新包，否则为重复或迟到的包
+    const uint8_t seq = h[1] & 0x0F;
+    if (seq != 0 && s_ddpSeq != 0) {
+        const uint8_t d = (uint8_t)(seq - s_ddpSeq) & 0x0F;
+        if (d == 0 || d > 7) return PacketResult::Stale;
+    }
+    if (seq != 0) s_ddpSeq = seq;
+
+    out.hdrLen = hdrLen;
+    out.offset = offset;
+    out.len = len;
+    out.push = (flags & kDdpFlagPush) || offset + len == kLedBytes; // 不带 PUSH 的发送端以写满为帧结束
+    return PacketResult::Accept;
+}
+
+static PacketResult parse_e131(const uint8_t* h, size_t n, StreamPacket& out) {
+    if (n < kE131HeaderLen) return PacketResult::Invalid;
+    if (rd16(h) != 0x0010 || memcmp(h + 4, kE131AcnId, sizeof(kE131AcnId)) != 0) return PacketResult::Invalid;
+    if (rd32(h + 18) != 0x00000004 || rd32(h + 40) != 0x00000002) return PacketResult::Invalid; // 数据包
+    if (h[117] != 0x02 || h[118] != 0xA1 || h[125] != 0x00) return PacketResult::Invalid;        // DMX 空起始码
+
+    // 先确认是我们的 universe 且来自当前发送端，再处理 Stream_Terminated：
+    // 其他 universe 或其他发送端的终止包不得停止本灯的流
+    const uint16_t universe = rd16(h + 113);
+    if (universe < UDP_STREAM_E131_UNIVERSE || universe >= UDP_STREAM_E131_UNIVERSE + kE131Universes) {
+        return PacketResult::Invalid;
+    }
+    const uint16_t index = universe - UDP_STREAM_E131_UNIVERSE;
+
+    const uint8_t* cid = h + kE131CidOffset;
+    if (s_e131CidValid && memcmp(cid, s_e131Cid, kE131CidLen) != 0) return PacketResult::Invalid;
+
+    const uint8_t options = h[112];
+    if (options & kE131OptTerminated) {
+        if (!s_e131CidValid) return PacketResult::Invalid; // 没有进行中的 E1.31 流
+        s_e131CidValid = false;
+        return PacketResult::Terminated;
+    }
+    if (options & kE131OptPreview) return PacketResult::Invalid;
+
+    const uint16_t count = rd16(h + 123); // 含起始码
+    if (count < 1 || count > 513) return PacketResult::Invalid;
+
+    // E1.31 6.7.2：与上一包相差 (-20, 0] 视为迟到，丢弃
+    const uint8_t seq = h[111];
+    if (s_e131SeqValid[index]) {
+        const int8_t d = (int8_t)(seq - s_e131Seq[index]);
+        if (d <= 0 && d > -20) return PacketResult::Stale;
+    }
+    s_e131Seq[index] = seq;
+    s_e131SeqValid[index] = true;
+    memcpy(s_e131Cid, cid, kE131CidLen);
+    s_e131CidValid = true;
+
+    const uint32_t offset = (uint32_t)index * kE131UniverseBytes;
+    uint32_t len = count - 1;
+    if (len > kE131UniverseBytes) len = kE131UniverseBytes;
+    if (len > kLedBytes - offset) len = kLedBytes - offset;
+
+    out.hdrLen = kE131HeaderLen;
+    out.offset = offset;
+    out.len = len;
+    out.push = index == kE131Universes - 1;
+    return PacketResult::Accept;
+}
+
+static void drop_packet(int sock) {
+    uint8_t b;
+    recv(sock, &b, 1, MSG_DONTWAIT);
+}
+
+/**
+ * @brief 处理一个套接字上排队的数据包
+ *
+ * 先 MSG_PEEK 读出头部并校验，再用 recvmsg() 分散读取：头部进栈上缓冲，
+ * 像素数据直接进后缓冲的目标偏移处，超出部分由内核截断丢弃。
+ */
+template <typename Parser>
+static void drain_socket(int sock, size_t peekLen, Parser parse, uint32_t rxUs) {
+    uint8_t hdr[kE131HeaderLen];
+    for (int i = 0; i < kMaxPacketsPerWake; i++) {
+        const ssize_t n = recv(sock, hdr, peekLen, MSG_PEEK | MSG_DONTWAIT);
+        if (n < 0) return; // 队列已空
+
+        const uint32_t now = millis();
+        reset_sequences_if_idle(now);
+
+        StreamPacket pkt{};
+        const PacketResult res = parse(hdr, (size_t)n, pkt);
+        if (res != PacketResult::Accept) {
+            drop_packet(sock);
+            if (res == PacketResult::Stale) s_stats.outOfOrder++;
+            else if (res == PacketResult::Invalid) s_stats.invalid++;
+            else lamp.endStream();
+            continue;
+        }
+        s_lastRxMs = now;
+
+        CRGB* leds = lamp.lockStreamBuffer(pdMS_TO_TICKS(20));
+        if (leds == nullptr) {
+            drop_packet(sock);
+            continue;
+        }
+        iovec iov[2] = {
+            {hdr, pkt.hdrLen},
+            {(uint8_t*)leds + pkt.offset, pkt.len},
+        };
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 2;
+        const ssize_t got = recvmsg(sock, &msg, MSG_DONTWAIT);
+        const uint32_t written = got > (ssize_t)pkt.hdrLen ? (uint32_t)(got - pkt.hdrLen) : 0;
+        lamp.unlockStreamBuffer(pkt.offset, written, pkt.push, rxUs);
+
+        if (written > 0) {
+            s_stats.packets++;
+            if (pkt.push) s_stats.frames++;
+        }
+        taskYIELD();
+    }
+}
+
+static int open_udp_socket(uint16_t port) {
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) return -1;
+
+    int yes = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(sock, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/**
+ * @brief 加入 E1.31 组播组 239.255.<universe 高字节>.<universe 低字节>
+ */
+static void join_e131_groups(int sock) {
+    for (uint16_t i = 0; i < kE131Universes; i++) {
+        const uint16_t universe = UDP_STREAM_E131_UNIVERSE + i;
+        ip_mreq mreq{};
+        mreq.imr_multiaddr.s_addr = htonl(0xEFFF0000u | universe);
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+            Serial.printf("[Stream] Join multicast universe %u failed\n", universe);
+        }
+    }
+}
+
+/**
+ * @brief 监听两个端口直到接收被关闭
+ *
+ * @return false 表示端口绑定失败
+ */
+static bool listen_until_disabled() {
+    const int ddp = open_udp_socket(UDP_STREAM_DDP_PORT);
+    const int e131 = open_udp_socket(UDP_STREAM_E131_PORT);
+    if (ddp < 0 || e131 < 0) {
+        Serial.println("[Stream] Socket bind failed");
+        if (ddp >= 0) close(ddp);
+        if (e131 >= 0) close(e131);
+        return false;
+    }
+    join_e131_groups(e131);
+    Serial.printf("[Stream] Listening DDP:%u E1.31:%u (universe %u)\n",
+                  UDP_STREAM_DDP_PORT, UDP_STREAM_E131_PORT, UDP_STREAM_E131_UNIVERSE);
+
+    const int maxFd = ddp > e131 ? ddp : e131;
+    while (s_enabled) {
+        fd_set rd;
+        FD_ZERO(&rd);
+        FD_SET(ddp, &rd);
+        FD_SET(e131, &rd);
+        timeval tv{1, 0};
+        if (select(maxFd + 1, &rd, nullptr, nullptr, &tv) <= 0) continue;
+
+        // 延迟统计的起点：数据包已到达协议栈
+        const uint32_t rxUs = micros();
+        if (FD_ISSET(ddp, &rd)) drain_socket(ddp, kDdpHeaderLen + kDdpTimecodeLen, parse_ddp, rxUs);
+        if (FD_ISSET(e131, &rd)) drain_socket(e131, kE131HeaderLen, parse_e131, rxUs);
+    }
+
+    close(ddp);
+    close(e131);
+    lamp.endStream();
+    Serial.println("[Stream] Receiver disabled");
+    return true;
+}
+
+static void task_udp_stream(void* pvParameters) {
+    (void)pvParameters;
+    for (;;) {
+        // 关闭期间只做低频轮询，不占用端口
+        while (!s_enabled || WiFi.status() != WL_CONNECTED) {
+            vTaskDelay(pdMS_TO_TICKS(1000));
+        }
+        if (!listen_until_disabled()) vTaskDelay(pdMS_TO_TICKS(5000)); // 端口被占用时稍后重试
+    }
+}
+
+// =================================================================================
+// 外部接口 (External Interface)
+// =================================================================================
+
+static void start_stream_task() {
+    if (s_streamTaskHandle != nullptr) return;
+    xTaskCreate(task_udp_stream, "Stream Task", 3072, NULL, kStreamTaskPriority, &s_streamTaskHandle);
+}
+
+void setup_udp_stream_task() {
+    bool enabled = false;
+    AppConfig::instance().loadStreamEnable(enabled);
+    s_enabled = enabled;
+    if (enabled) start_stream_task(); // 从未开启时不创建任务，不占用栈
+}
+
+void udp_stream_set_enable(bool enable) {
+    AppConfig::instance().saveStreamEnable(enable);
+    s_enabled = enable;
+    if (enable) start_stream_task();
+    Serial.printf("[Stream] Receiver %s\n", enable ? "enabled" : "disabled");
+}
+
+bool udp_stream_is_enabled() {
+    return s_enabled;
+}
+
+void udp_stream_get_stats(UdpStreamStats& out) {
+    out = s_stats;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file udp_stream.hpp
+ * @brief 实时像素流接收 (DDP / E1.31 sACN)
+ *
+ * 上位机 (xLights、Hyperion、LedFx 等) 以 UDP 推送整帧像素，用于环境光同步。
+ * 像素直接收进 LampController 的后缓冲，停止推送后灯光自动恢复当前特效。
+ *
+ * 接收端没有认证，局域网内任何主机都能接管灯光，因此默认关闭，
+ * 由系统指令 "stream:on" / "stream:off" (BLE / MQTT) 开启并持久化。
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+static constexpr uint16_t UDP_STREAM_DDP_PORT = 4048;   // DDP 标准端口
+static constexpr uint16_t UDP_STREAM_E131_PORT = 5568;  // E1.31 (sACN) 标准端口
+static constexpr uint16_t UDP_STREAM_E131_UNIVERSE = 1; // 第一个像素所在的 universe
+
+// 接收统计
+struct UdpStreamStats {
+    uint32_t packets;     // 写入后缓冲的数据包
+    uint32_t frames;      // 完整帧 (DDP PUSH / 覆盖最后一个像素的 E1.31 universe)
+    uint32_t outOfOrder;  // 序号落后而丢弃的数据包
+    uint32_t invalid;     // 格式错误、目标不符或超出像素范围的数据包
+};
+
+/**
+ * @brief 启动实时像素流接收任务 (仅当已开启)
+ *
+ * 等待 WiFi 连接后监听 DDP 与 E1.31 端口，并加入 E1.31 的组播组。
+ */
+void setup_udp_stream_task();
+
+/**
+ * @brief 开启/关闭实时像素流接收并保存到 NVS
+ *
+ * 关闭时释放端口，正在进行的流立即结束。
+ */
+void udp_stream_set_enable(bool enable);
+
+/**
+ * @brief 实时像素流接收是否开启
+ */
+bool udp_stream_is_enabled();
+
+/**
+ * @brief 获取接收统计
+ */
+void udp_stream_get_stats(UdpStreamStats& out);
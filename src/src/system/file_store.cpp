@@ -0,0 +1,19 @@
+#include "file_store.hpp"
+
+static bool s_mounted = false;
+
+bool file_store_begin() {
+    if (s_mounted) return true;
+    // 同时打开的文件：动画播放 1 + 上传 1
+    s_mounted = LittleFS.begin(true, "/littlefs", 4, "spiffs");
+    if (s_mounted) {
+        Serial.printf("[FS] Mounted: %u / %u bytes used\n", (unsigned)LittleFS.usedBytes(), (unsigned)LittleFS.totalBytes());
+    } else {
+        Serial.println("[FS] Mount failed");
+    }
+    return s_mounted;
+}
+
+bool file_store_ready() {
+    return s_mounted;
+}
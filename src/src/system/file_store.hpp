@@ -0,0 +1,16 @@
+#pragma once
+#include <Arduino.h>
+#include <LittleFS.h>
+
+/**
+ * @brief 文件存储 (partitions.csv 中的 spiffs 分区，以 LittleFS 挂载)
+ *
+ * 用于存放体积较大、NVS 放不下的数据 (如上传的动画)。
+ * 首次挂载失败时格式化分区，格式化 960KB 约需数秒，应在启动阶段调用。
+ */
+bool file_store_begin();
+
+/**
+ * @brief 分区是否已挂载
+ */
+bool file_store_ready();
@@ -227,6 +227,56 @@ void AppConfig::saveAutoBrightness(bool enabled) {
     prefs_.putInt("auto_br", enabled ? 1 : 0);
 }
 
+size_t AppConfig::loadEffectParams(void *buf, size_t maxLen) {
+    begin();
+    const size_t len = prefs_.getBytesLength(K_EFFECT_PARAMS);
+    if (len == 0 || len > maxLen) return 0;
+    return prefs_.getBytes(K_EFFECT_PARAMS, buf, len);
+}
+
+void AppConfig::saveEffectParams(const void *buf, size_t len) {
+    begin();
+    prefs_.putBytes(K_EFFECT_PARAMS, buf, len);
+}
+
+bool AppConfig::loadCctCalibration(int16_t *m, size_t len) {
+    begin();
+    if (prefs_.getBytesLength(K_CCT_CAL) != len) return false;
+    return prefs_.getBytes(K_CCT_CAL, m, len) == len;
+}
+
+void AppConfig::saveCctCalibration(const int16_t *m, size_t len) {
+    begin();
+    prefs_.putBytes(K_CCT_CAL, m, len);
+}
+
+size_t AppConfig::loadScenes(void *buf, size_t maxLen) {
+    begin();
+    const size_t len = prefs_.getBytesLength(K_SCENES);
+    if (len == 0 || len > maxLen) return 0;
+    return prefs_.getBytes(K_SCENES, buf, len);
+}
+
+bool AppConfig::loadZones(void *buf, size_t len) {
+    begin();
+    if (prefs_.getBytesLength(K_ZONES) != len) return false;
+    return prefs_.getBytes(K_ZONES, buf, len) == len;
+}
+
+void AppConfig::saveZones(const void *buf, size_t len) {
+    begin();
+    prefs_.putBytes(K_ZONES, buf, len);
+}
+
+void AppConfig::saveScenes(const void *buf, size_t len) {
+    begin();
+    if (len == 0) {
+        prefs_.remove(K_SCENES);
+        return;
+    }
+    prefs_.putBytes(K_SCENES, buf, len);
+}
+
 bool AppConfig::loadDebugMode(bool &enabled) {
     begin();
     enabled = prefs_.getBool(K_DEBUG, false); // 默认关闭
@@ -239,6 +289,12 @@ bool AppConfig::loadRadarEnable(bool &enabled) {
     return true;
 }
 
+bool AppConfig::loadStreamEnable(bool &enabled) {
+    begin();
+    enabled = prefs_.getBool(K_STREAM, false); // 默认关闭：接收端无认证
+    return true;
+}
+
 void AppConfig::saveDebugMode(bool enabled) {
     begin();
     prefs_.putBool(K_DEBUG, enabled);
@@ -249,6 +305,11 @@ void AppConfig::saveRadarEnable(bool enabled) {
     prefs_.putBool("radar_en", enabled);
 }
 
+void AppConfig::saveStreamEnable(bool enabled) {
+    begin();
+    prefs_.putBool(K_STREAM, enabled);
+}
+
 void AppConfig::putInt(const char* key, int32_t value) {
     begin();
     prefs_.putInt(key, value);
@@ -30,6 +30,11 @@ public:
     bool loadAutoBrightness(bool &enabled);
     bool loadDebugMode(bool &enabled);
     bool loadRadarEnable(bool &enabled);
+    bool loadStreamEnable(bool &enabled);          // 实时像素流 (DDP / E1.31) 接收，默认关闭
+    size_t loadEffectParams(void *buf, size_t maxLen); // 返回字节数 (旧固件特效较少时短于 maxLen；未保存或超长时为 0)
+    bool loadCctCalibration(int16_t *m, size_t len); // 3x3 Q12 矩阵，未保存时返回 false
+    size_t loadScenes(void *buf, size_t maxLen);     // 用户场景数组，返回字节数 (未保存或超长时为 0)
+    bool loadZones(void *buf, size_t len);           // 分区状态，存储长度与 len 不一致时返回 false
 
     struct WifiCred {
         String ssid;
@@ -53,6 +58,11 @@ public:
     void saveAutoBrightness(bool enabled);
     void saveDebugMode(bool enabled);
     void saveRadarEnable(bool enabled);
+    void saveStreamEnable(bool enabled);
+    void saveEffectParams(const void *buf, size_t len);
+    void saveCctCalibration(const int16_t *m, size_t len);
+    void saveScenes(const void *buf, size_t len);
+    void saveZones(const void *buf, size_t len);
 
     // Generic helper (if needed publicly, otherwise keep private or specific)
     void putInt(const char* key, int32_t value);
@@ -79,5 +89,10 @@ private:
     static constexpr const char *K_LON = "lon";
     static constexpr const char *K_CITY = "city";
     static constexpr const char *K_DEBUG = "debug";
+    static constexpr const char *K_EFFECT_PARAMS = "fx_params";
+    static constexpr const char *K_CCT_CAL = "cct_cal";
+    static constexpr const char *K_SCENES = "scenes";
+    static constexpr const char *K_ZONES = "zones";
+    static constexpr const char *K_STREAM = "stream_en";
 };
 
@@ -16,6 +16,7 @@
 #include "../network/ble_task.hpp"
 #include "../network/weather_task.hpp"
 #include "screens/screen_main.hpp"
+#include "screens/screen_lamp.hpp"
 #include "../app/lamp.hpp"
 
 // =================================================================================
@@ -147,6 +148,7 @@ bool gui_is_power_save_mode() {
 void gui_set_power_save_mode(bool enabled) {
     s_powerSaveMode = enabled;
     AppConfig::instance().savePowerSaveMode(enabled);
+    lamp.setReducedFrameRate(enabled); // 省电模式下灯效降至 25fps
     Serial.printf("[GUI] Power Save Mode: %s\n", enabled ? "ON" : "OFF");
 }
 
@@ -165,6 +167,7 @@ static void task_gui(void *pvParameters) {
 
     // 加载省电模式配置
     AppConfig::instance().loadPowerSaveMode(s_powerSaveMode);
+    lamp.setReducedFrameRate(s_powerSaveMode);
 
     Serial.println("[GUI] Interface initialized");
     
@@ -295,6 +298,19 @@ static void task_gui(void *pvParameters) {
                 case UI_EVENT_CCT:
                     ui_update_cct((uint16_t)evt.value);
                     break;
+                case UI_EVENT_SCENE: {
+                    // 场景一次性改变亮度与颜色，从快照读取目标值
+                    LampStateSnapshot st;
+                    lamp.getState(st);
+                    ui_update_brightness(st.savedBrightness);
+                    if (st.cctMode) ui_update_cct(st.cct);
+                    ui_lamp_update_fx_params();
+                    break;
+                }
+                case UI_EVENT_EFFECT:
+                    // 特效或其参数变化，参数从快照读取
+                    ui_lamp_update_fx_params();
+                    break;
                 case UI_EVENT_WIFI_IP:
                     ui_update_ip(s_ipBuffer);
                     break;
@@ -316,10 +332,12 @@ static void task_gui(void *pvParameters) {
                 case UI_EVENT_HUMIDITY:
                     ui_update_humidity(evt.fvalue);
                     break;
-                case UI_EVENT_LUX:
+                case UI_EVENT_LUX: {
                     ui_update_lux(evt.fvalue);
                     // 自动亮度逻辑
-                    if (lamp.isAutoBrightness()) {
+                    LampStateSnapshot st;
+                    lamp.getState(st);
+                    if (st.autoBrightness) {
                         float lux = evt.fvalue;
                         uint8_t targetBr = 0;
                         
@@ -334,11 +352,12 @@ static void task_gui(void *pvParameters) {
                         }
                         
                         // 只有当变化超过一定阈值时才调整，避免频繁闪烁
-                        if (abs(targetBr - lamp.getBrightness()) > 2) {
+                        if (abs(targetBr - st.brightness) > 2) {
                             lamp.setBrightness(targetBr, 2000); // 2秒平滑过渡
                         }
                     }
                     break;
+                }
                 case UI_EVENT_RADAR_DIST:
                     ui_update_radar_dist(evt.value);
                     break;
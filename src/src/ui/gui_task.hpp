@@ -42,7 +42,9 @@ enum UIEventType : uint8_t {
     UI_EVENT_LUX         = 18,     // fvalue: lux
     UI_EVENT_RADAR_DIST  = 19,     // value: distance in cm
     UI_EVENT_RADAR_STATE = 20,     // value: 0=No Target, 1=Moving, 2=Stationary
-    UI_EVENT_WEATHER     = 21      // value: weather update event
+    UI_EVENT_WEATHER     = 21,     // value: weather update event
+    UI_EVENT_SCENE       = 22,     // value: scene_hash()；亮度与颜色从状态快照读取
+    UI_EVENT_ZONE        = 23      // value: 分区序号 (从 0 开始)；状态从快照读取
 };
 
 struct UIEvent { 
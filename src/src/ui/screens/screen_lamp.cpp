@@ -23,6 +23,19 @@ static lv_obj_t *label_cct = nullptr;
 static lv_obj_t *item_auto_br = nullptr;
 static lv_obj_t *sw_auto_br = nullptr;
 
+// 当前特效的参数
+static lv_obj_t *item_fx_speed = nullptr;
+static lv_obj_t *slider_fx_speed = nullptr;
+static lv_obj_t *label_fx_speed = nullptr;
+
+static lv_obj_t *item_fx_intensity = nullptr;
+static lv_obj_t *slider_fx_intensity = nullptr;
+static lv_obj_t *label_fx_intensity = nullptr;
+
+static lv_obj_t *item_fx_palette = nullptr;
+static lv_obj_t *label_fx_palette = nullptr;
+static uint8_t s_fxPalette = 0;
+
 // 使用公共样式函数 `ui_apply_style`
 
 // 使用公共创建函数（滑块/开关项已迁移到 ui_common）
@@ -42,7 +55,9 @@ lv_obj_t* ui_create_lamp_screen(lv_obj_t *parent) {
     // 1. Brightness
     item_brightness = ui_create_slider_item(cont_lamp, "Brightness", &slider_brightness, &label_brightness);
     lv_slider_set_range(slider_brightness, 0, 100);
-    uint8_t uiBr = lamp.getSavedBrightness();
+    LampStateSnapshot st;
+    lamp.getState(st);
+    uint8_t uiBr = st.savedBrightness;
     lv_slider_set_value(slider_brightness, uiBr, LV_ANIM_OFF);
     lv_label_set_text_fmt(label_brightness, "%d%%", uiBr);
     ui_apply_style(item_brightness, false, false); // Apply default style
@@ -50,20 +65,39 @@ lv_obj_t* ui_create_lamp_screen(lv_obj_t *parent) {
     // 2. CCT
     item_cct = ui_create_slider_item(cont_lamp, "Color Temp", &slider_cct, &label_cct);
     lv_slider_set_range(slider_cct, LAMP_CCT_MIN, LAMP_CCT_MAX);
-    lv_slider_set_value(slider_cct, lamp.getCCT(), LV_ANIM_OFF);
-    lv_label_set_text_fmt(label_cct, "%dK", lamp.getCCT());
+    lv_slider_set_value(slider_cct, st.cct, LV_ANIM_OFF);
+    lv_label_set_text_fmt(label_cct, "%dK", st.cct);
     ui_apply_style(item_cct, false, false); // Apply default style
 
     // 3. Auto Brightness
     item_auto_br = ui_create_basic_list_item(cont_lamp, "Auto Brightness", &sw_auto_br);
-    if (lamp.isAutoBrightness()) lv_obj_add_state(sw_auto_br, LV_STATE_CHECKED);
+    if (st.autoBrightness) lv_obj_add_state(sw_auto_br, LV_STATE_CHECKED);
     ui_apply_style(item_auto_br, false, false); // Apply default style
 
+    // 4. Effect Speed (128 = 原速)
+    item_fx_speed = ui_create_slider_item(cont_lamp, "Effect Speed", &slider_fx_speed, &label_fx_speed);
+    lv_slider_set_range(slider_fx_speed, 0, 255);
+    lv_slider_set_value(slider_fx_speed, st.params.speed, LV_ANIM_OFF);
+    lv_label_set_text_fmt(label_fx_speed, "%d", st.params.speed);
+    ui_apply_style(item_fx_speed, false, false);
+
+    // 5. Effect Intensity
+    item_fx_intensity = ui_create_slider_item(cont_lamp, "Effect Intensity", &slider_fx_intensity, &label_fx_intensity);
+    lv_slider_set_range(slider_fx_intensity, 0, 255);
+    lv_slider_set_value(slider_fx_intensity, st.params.intensity, LV_ANIM_OFF);
+    lv_label_set_text_fmt(label_fx_intensity, "%d", st.params.intensity);
+    ui_apply_style(item_fx_intensity, false, false);
+
+    // 6. Palette (编辑时左右切换)
+    item_fx_palette = ui_create_info_item(cont_lamp, LV_SYMBOL_IMAGE, "Palette", &label_fx_palette);
+    s_fxPalette = (uint8_t)st.params.palette;
+    lv_label_set_text(label_fx_palette, palette_name(st.params.palette));
+    ui_apply_style(item_fx_palette, false, false);
+
     // Events
     lv_obj_add_event_cb(slider_brightness, [](lv_event_t *e){
         lv_obj_t * obj = (lv_obj_t*)lv_event_get_target(e);
         int v = lv_slider_get_value(obj);
-        lamp.cancelFade();
         lamp.setBrightness((uint8_t)v);
         if (v > 0) lamp.setSavedBrightness((uint8_t)v);
         if (label_brightness) lv_label_set_text_fmt(label_brightness, "%d%%", v);
@@ -83,6 +117,22 @@ lv_obj_t* ui_create_lamp_screen(lv_obj_t *parent) {
         lamp.setAutoBrightness(checked);
     }, LV_EVENT_VALUE_CHANGED, nullptr);
 
+    lv_obj_add_event_cb(slider_fx_speed, [](lv_event_t *e){
+        lv_obj_t * obj = (lv_obj_t*)lv_event_get_target(e);
+        EffectParams p = {};
+        p.speed = (uint8_t)lv_slider_get_value(obj);
+        lamp.setEffectParams(p, EFP_SPEED);
+        if (label_fx_speed) lv_label_set_text_fmt(label_fx_speed, "%d", p.speed);
+    }, LV_EVENT_VALUE_CHANGED, nullptr);
+
+    lv_obj_add_event_cb(slider_fx_intensity, [](lv_event_t *e){
+        lv_obj_t * obj = (lv_obj_t*)lv_event_get_target(e);
+        EffectParams p = {};
+        p.intensity = (uint8_t)lv_slider_get_value(obj);
+        lamp.setEffectParams(p, EFP_INTENSITY);
+        if (label_fx_intensity) lv_label_set_text_fmt(label_fx_intensity, "%d", p.intensity);
+    }, LV_EVENT_VALUE_CHANGED, nullptr);
+
     return win_lamp;
 }
 
@@ -103,6 +153,9 @@ void ui_lamp_apply_focus(bool editMode, int focusIndex) {
     ui_apply_style(item_brightness, focusIndex == 0, editMode && focusIndex == 0);
     ui_apply_style(item_cct, focusIndex == 1, editMode && focusIndex == 1);
     ui_apply_style(item_auto_br, focusIndex == 2, editMode && focusIndex == 2);
+    ui_apply_style(item_fx_speed, focusIndex == 3, editMode && focusIndex == 3);
+    ui_apply_style(item_fx_intensity, focusIndex == 4, editMode && focusIndex == 4);
+    ui_apply_style(item_fx_palette, focusIndex == 5, editMode && focusIndex == 5);
 
     // Auto-scroll to focused item
     if (focusIndex >= 0) {
@@ -110,6 +163,9 @@ void ui_lamp_apply_focus(bool editMode, int focusIndex) {
         if (focusIndex == 0) target = item_brightness;
         else if (focusIndex == 1) target = item_cct;
         else if (focusIndex == 2) target = item_auto_br;
+        else if (focusIndex == 3) target = item_fx_speed;
+        else if (focusIndex == 4) target = item_fx_intensity;
+        else if (focusIndex == 5) target = item_fx_palette;
 
         if (target) lv_obj_scroll_to_view(target, LV_ANIM_ON);
     }
@@ -119,6 +175,24 @@ void ui_lamp_clear_focus() {
     ui_apply_style(item_brightness, false);
     ui_apply_style(item_cct, false);
     ui_apply_style(item_auto_br, false);
+    ui_apply_style(item_fx_speed, false);
+    ui_apply_style(item_fx_intensity, false);
+    ui_apply_style(item_fx_palette, false);
+}
+
+/**
+ * @brief 调整特效参数滑块 (0-255) 并下发到当前特效
+ */
+static void lamp_nav_fx_slider(lv_obj_t *slider, lv_obj_t *label, uint8_t field, int delta) {
+    int v = lv_slider_get_value(slider) + delta;
+    if (v < 0) v = 0;
+    if (v > 255) v = 255;
+    EffectParams p = {};
+    if (field == EFP_SPEED) p.speed = (uint8_t)v;
+    else p.intensity = (uint8_t)v;
+    lamp.setEffectParams(p, field);
+    lv_slider_set_value(slider, v, LV_ANIM_OFF);
+    if (label) lv_label_set_text_fmt(label, "%d", v);
 }
 
 void ui_lamp_handle_nav(int dir, bool editMode, int focusIndex) {
@@ -128,7 +202,6 @@ void ui_lamp_handle_nav(int dir, bool editMode, int focusIndex) {
         v += dir * step;
         if (v < 0) v = 0;
         if (v > 100) v = 100;
-        lamp.cancelFade();
         lamp.setBrightness((uint8_t)v);
         if (v > 0) lamp.setSavedBrightness((uint8_t)v);
         lv_slider_set_value(slider_brightness, v, LV_ANIM_OFF);
@@ -150,6 +223,18 @@ void ui_lamp_handle_nav(int dir, bool editMode, int focusIndex) {
         if (next) lv_obj_add_state(sw_auto_br, LV_STATE_CHECKED);
         else lv_obj_clear_state(sw_auto_br, LV_STATE_CHECKED);
         lamp.setAutoBrightness(next);
+    } else if (focusIndex == 3 && slider_fx_speed) {
+        lamp_nav_fx_slider(slider_fx_speed, label_fx_speed, EFP_SPEED, dir * (editMode ? 16 : 4));
+    } else if (focusIndex == 4 && slider_fx_intensity) {
+        lamp_nav_fx_slider(slider_fx_intensity, label_fx_intensity, EFP_INTENSITY, dir * (editMode ? 16 : 4));
+    } else if (focusIndex == 5 && label_fx_palette) {
+        // 在全部调色板之间循环
+        const int count = (int)PaletteId::Count;
+        s_fxPalette = (uint8_t)((s_fxPalette + dir + count) % count);
+        EffectParams p = {};
+        p.palette = (PaletteId)s_fxPalette;
+        lamp.setEffectParams(p, EFP_PALETTE);
+        lv_label_set_text(label_fx_palette, palette_name(p.palette));
     }
 }
 
@@ -173,3 +258,18 @@ void ui_lamp_update_cct(uint16_t cct) {
         if (label_cct) lv_label_set_text_fmt(label_cct, "%dK", cct);
     }
 }
+
+void ui_lamp_update_fx_params() {
+    LampStateSnapshot st;
+    lamp.getState(st);
+    if (slider_fx_speed) {
+        lv_slider_set_value(slider_fx_speed, st.params.speed, LV_ANIM_OFF);
+        if (label_fx_speed) lv_label_set_text_fmt(label_fx_speed, "%d", st.params.speed);
+    }
+    if (slider_fx_intensity) {
+        lv_slider_set_value(slider_fx_intensity, st.params.intensity, LV_ANIM_OFF);
+        if (label_fx_intensity) lv_label_set_text_fmt(label_fx_intensity, "%d", st.params.intensity);
+    }
+    s_fxPalette = (uint8_t)st.params.palette;
+    if (label_fx_palette) lv_label_set_text(label_fx_palette, palette_name(st.params.palette));
+}
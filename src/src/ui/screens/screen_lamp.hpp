@@ -2,7 +2,7 @@
  * @file screen_lamp.hpp
  * @brief 灯光控制屏幕 (Lamp Control Screen)
  * 
- * 提供亮度与色温的调节界面。
+ * 提供亮度、色温以及当前特效参数 (速度/强度/调色板) 的调节界面。
  */
 
 #pragma once
@@ -47,6 +47,11 @@ void ui_lamp_update_cct(uint16_t val);
  */
 void ui_lamp_update_auto_brightness(bool enabled);
 
+/**
+ * @brief 按状态快照更新特效速度/强度/调色板显示 (当前特效)
+ */
+void ui_lamp_update_fx_params();
+
 // =================================================================================
 // 导航与焦点 (Navigation & Focus)
 // =================================================================================
@@ -54,7 +59,7 @@ void ui_lamp_update_auto_brightness(bool enabled);
 /**
  * @brief 应用焦点样式
  * @param editMode 是否处于编辑模式 (调整数值)
- * @param focusIndex 0=亮度, 1=色温, 2=自动亮度
+ * @param focusIndex 0=亮度, 1=色温, 2=自动亮度, 3=特效速度, 4=特效强度, 5=调色板
  */
 void ui_lamp_apply_focus(bool editMode, int focusIndex);
 
@@ -31,7 +31,7 @@ static bool s_inScreensaver = false;
 
 // 灯光屏幕状态
 static bool s_lampEditMode = false;       // true 表示正在编辑滑块数值
-static int s_lampFocusIndex = 0;          // 0=亮度, 1=色温, 2=自动亮度
+static int s_lampFocusIndex = 0;          // 0=亮度, 1=色温, 2=自动亮度, 3=特效速度, 4=特效强度, 5=调色板
 
 // 设置屏幕状态
 static int s_settingsFocusIndex = 0;      // 0=省电模式, 1=雷达开关, 2=Debug模式, 3=WiFi列表
@@ -253,10 +253,10 @@ void ui_nav(int dir) {
         // ---- 菜单内导航模式 (In-Menu Navigation Mode) ----
         if (s_currentWindow == 1) { // 灯光屏幕
              if (!s_lampEditMode) {
-                 // 焦点导航: 在亮度、色温、自动亮度之间切换
+                 // 焦点导航: 在亮度、色温、自动亮度与特效参数之间切换
                  s_lampFocusIndex += dir;
                  if (s_lampFocusIndex < 0) s_lampFocusIndex = 0;
-                 if (s_lampFocusIndex > 2) s_lampFocusIndex = 2;
+                 if (s_lampFocusIndex > 5) s_lampFocusIndex = 5;
                  ui_lamp_apply_focus(s_lampEditMode, s_lampFocusIndex);
              } else {
                  // 数值调整: 改变滑块值